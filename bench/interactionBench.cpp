@@ -0,0 +1,286 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// End-to-end interaction benchmark: a ZoomAndScroll chart on the offscreen
+// platform, driven by synthetic mouse-move sweeps, wheel zooms, right-drag
+// pans and rubber-band zooms sent through its event handlers, with tracking
+// off, crosshair or truncated track lines, and focus (hover) mode.
+// Each event is timed from delivery until its frame is handled, the tracking
+// batch is rendered and the view repainted; the view is let go idle before
+// each event, so the frame clock's wait is not counted. The quality governor
+// is disabled to keep every frame at full quality.
+// One JSON object per line on stdout for each configuration, e.g.
+//   {"series":4,"points":100000,"mode":"crosshair","sequence":"move","events":400,"p50_ms":0.8,...}
+// Series and points take comma-separated lists (1e5 notation allowed), so a
+// single run yields a whole scaling curve.
+// Usage: interactionBench [series,...] [points,...] [events per sequence]
+
+#include "customEvents.h"
+#include "frameScheduler.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QValueAxis>
+#include <QWheelEvent>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Mode {
+        const char *name;
+        bool tracking;
+        bool crosshair;
+        bool focus;
+    };
+
+    constexpr Mode modes[] = {
+        {"off", false, false, false},
+        {"crosshair", true, true, false},
+        {"truncated", true, false, false},
+        {"focus", false, false, true},
+    };
+
+    std::vector<qsizetype> parseList(const char *text) {
+        std::vector<qsizetype> values;
+        char *end = nullptr;
+        for (const char *p = text; *p; p = *end == ',' ? end + 1 : end) {
+            const double value = std::strtod(p, &end);
+            if (end == p || value < 1) {
+                return {};
+            }
+            values.push_back(static_cast<qsizetype>(value));
+        }
+        return values;
+    }
+
+    QList<QPointF> makeSeries(const qsizetype count, const int index) {
+        std::mt19937_64 random(index);
+        std::normal_distribution<qreal> noise(0, 0.05);
+        QList<QPointF> points(count);
+        const qreal frequency = 1.0 + index * 0.37;
+        for (qsizetype i = 0; i < count; ++i) {
+            const qreal x = static_cast<qreal>(i) / static_cast<qreal>(count) * 100;
+            points[i] = QPointF(x, std::sin(x * frequency * 0.2) + index + noise(random));
+        }
+        return points;
+    }
+
+    class Driver {
+    public:
+        explicit Driver(ZoomAndScroll &view) : m_view(view) {
+        }
+
+        // Processes events until no frame has ticked for a few frame intervals.
+        void settle() const {
+            const FrameScheduler *scheduler = FrameScheduler::instance();
+            const qint64 quiet = 3 * scheduler->frameInterval();
+            quint64 frames = scheduler->frameCount();
+            QElapsedTimer clock;
+            clock.start();
+            while (clock.elapsed() < quiet) {
+                QCoreApplication::processEvents();
+                if (scheduler->frameCount() != frames) {
+                    frames = scheduler->frameCount();
+                    clock.restart();
+                }
+            }
+            scheduler->waitForBatch();
+            QCoreApplication::processEvents();
+        }
+
+        // Delivers one event to an idle view and records the time, in ms,
+        // until it is fully handled and painted (when timed).
+        void send(QEvent &event, const bool timed = true) {
+            settle();
+            QElapsedTimer clock;
+            clock.start();
+            // An idle scheduler handles a move within this call
+            QCoreApplication::sendEvent(m_view.viewport(), &event);
+            FrameScheduler::instance()->waitForBatch();
+            QCoreApplication::processEvents(); // Batch results
+            QCoreApplication::processEvents(); // Repaint they requested
+            if (timed) {
+                m_latencies.push_back(static_cast<double>(clock.nsecsElapsed()) / 1e6);
+            }
+        }
+
+        void mouse(const QEvent::Type type, const QPointF &pos, const Qt::MouseButton button,
+                   const Qt::MouseButtons buttons, const bool timed = true) {
+            QMouseEvent event(type, pos, m_view.viewport()->mapToGlobal(pos), button, buttons, Qt::NoModifier);
+            send(event, timed);
+        }
+
+        void wheel(const QPointF &pos, const int degrees, const bool timed = true) {
+            QWheelEvent event(pos, m_view.viewport()->mapToGlobal(pos), QPoint(), QPoint(0, degrees * 8),
+                              Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+            send(event, timed);
+        }
+
+        void reset() {
+            mouse(QEvent::MouseButtonDblClick, plotPoint(0.5, 0.5), Qt::LeftButton, Qt::LeftButton, false);
+        }
+
+        // Viewport position at a fraction of the plot area
+        [[nodiscard]] QPointF plotPoint(const qreal fx, const qreal fy) const {
+            const QRectF plot = m_view.chart()->plotArea();
+            return m_view.mapFromScene(QPointF(plot.left() + fx * plot.width(),
+                                               plot.top() + fy * plot.height()));
+        }
+
+        // Takes the latencies recorded so far and prints their distribution.
+        void report(const qsizetype series, const qsizetype points, const char *mode, const char *sequence) {
+            std::vector<double> ms;
+            ms.swap(m_latencies);
+            std::sort(ms.begin(), ms.end());
+            const auto percentile = [&ms](const double p) {
+                const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(ms.size())));
+                return ms[std::clamp<size_t>(rank, 1, ms.size()) - 1];
+            };
+            double sum = 0;
+            for (const double value: ms) {
+                sum += value;
+            }
+            std::printf(R"({"series":%lld,"points":%lld,"mode":"%s","sequence":"%s","events":%zu,)"
+                        R"("p50_ms":%.4f,"p90_ms":%.4f,"p99_ms":%.4f,"max_ms":%.4f,"mean_ms":%.4f})"
+                        "\n", static_cast<long long>(series), static_cast<long long>(points), mode, sequence,
+                        ms.size(), percentile(0.50), percentile(0.90), percentile(0.99), ms.back(),
+                        sum / static_cast<double>(ms.size()));
+            std::fflush(stdout);
+        }
+
+    private:
+        ZoomAndScroll &m_view;
+        std::vector<double> m_latencies;
+    };
+
+    // Same chart setup as the example window, every series decimated
+    void buildChart(ZoomAndScroll &view, QChart *chart, const qsizetype seriesCount, const qsizetype points) {
+        for (qsizetype s = 0; s < seriesCount; ++s) {
+            auto *series = new LineSeries(&view);
+            series->setDecimatedData(makeSeries(points, static_cast<int>(s)));
+            series->setName(QString("Series %1").arg(static_cast<qint64>(s + 1)));
+            chart->addSeries(series);
+        }
+        view.updateXLimits(chart);
+        chart->createDefaultAxes();
+        for (QAbstractAxis *axis: chart->axes()) {
+            if (auto *valueAxis = qobject_cast<QValueAxis *>(axis)) {
+                if (axis->orientation() == Qt::Horizontal) {
+                    valueAxis->setRange(view.minX, view.maxX);
+                } else {
+                    valueAxis->setRange(view.minY, view.maxY);
+                }
+            }
+        }
+        view.rangeUpdate();
+    }
+
+    void runSequences(ZoomAndScroll &view, Driver &driver, const qsizetype seriesCount, const qsizetype points,
+                      const Mode &mode, const int events) {
+        view.toggleState = mode.tracking;
+        view.toggleLines = mode.crosshair;
+        view.toggleFocus = mode.focus;
+        const auto sweep = [](const int i) {
+            // Back and forth across the plot, a few pixels per move
+            const qreal t = static_cast<qreal>(i % 200) / 200;
+            return 0.05 + 0.9 * (i / 200 % 2 == 0 ? t : 1 - t);
+        };
+
+        // Cursor sweep
+        for (int i = 0; i < events; ++i) {
+            driver.mouse(QEvent::MouseMove, driver.plotPoint(sweep(i), 0.5), Qt::NoButton, Qt::NoButton);
+        }
+        driver.report(seriesCount, points, mode.name, "move");
+
+        // Wheel: zoom in then back out, around a point off-center
+        for (int i = 0; i < events; ++i) {
+            driver.wheel(driver.plotPoint(0.4, 0.6), i % 20 < 10 ? 15 : -15);
+        }
+        driver.report(seriesCount, points, mode.name, "wheel");
+        driver.reset();
+
+        // Right-drag pan, zoomed in so there is room to move
+        driver.wheel(driver.plotPoint(0.5, 0.5), 15, false);
+        driver.wheel(driver.plotPoint(0.5, 0.5), 15, false);
+        driver.mouse(QEvent::MouseButtonPress, driver.plotPoint(0.5, 0.5), Qt::RightButton, Qt::RightButton);
+        for (int i = 0; i < events; ++i) {
+            driver.mouse(QEvent::MouseMove, driver.plotPoint(sweep(i), 0.5 + 0.1 * std::sin(i * 0.1)),
+                         Qt::NoButton, Qt::RightButton);
+        }
+        driver.mouse(QEvent::MouseButtonRelease, driver.plotPoint(0.5, 0.5), Qt::RightButton, Qt::NoButton);
+        driver.report(seriesCount, points, mode.name, "pan");
+        driver.reset();
+
+        // Rubber band: several drags, each released into a zoom and reset
+        constexpr int dragMoves = 50;
+        for (int i = 0; i < events; i += dragMoves) {
+            driver.mouse(QEvent::MouseButtonPress, driver.plotPoint(0.2, 0.2), Qt::LeftButton, Qt::LeftButton);
+            for (int j = 1; j <= dragMoves; ++j) {
+                const qreal t = 0.2 + 0.6 * j / dragMoves;
+                driver.mouse(QEvent::MouseMove, driver.plotPoint(t, t), Qt::NoButton, Qt::LeftButton);
+            }
+            driver.mouse(QEvent::MouseButtonRelease, driver.plotPoint(0.8, 0.8), Qt::LeftButton, Qt::NoButton);
+            driver.reset();
+        }
+        driver.report(seriesCount, points, mode.name, "rubberBand");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const std::vector<qsizetype> seriesCounts = parseList(argc > 1 ? argv[1] : "1,4,16");
+    const std::vector<qsizetype> pointCounts = parseList(argc > 2 ? argv[2] : "1e4,1e5,1e6");
+    const int events = argc > 3 ? std::atoi(argv[3]) : 400;
+    if (seriesCounts.empty() || pointCounts.empty() || events < 1) {
+        std::fprintf(stderr, "usage: %s [series,...] [points,...] [events per sequence]\n", argv[0]);
+        return 1;
+    }
+
+    // Headless unless told otherwise
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    int qtArgc = 1;
+    QApplication app(qtArgc, argv);
+    FrameScheduler::instance()->setFrameInterval(1); // Short idle detection between events
+
+    for (const qsizetype seriesCount: seriesCounts) {
+        for (const qsizetype points: pointCounts) {
+            std::fprintf(stderr, "%lld series x %lld points\n", static_cast<long long>(seriesCount),
+                         static_cast<long long>(points));
+            auto *chart = new QChart();
+            ZoomAndScroll view(chart);
+            view.setFrameBudget(-1);
+            buildChart(view, chart, seriesCount, points);
+            view.resize(1280, 720);
+            view.show();
+
+            Driver driver(view);
+            driver.settle();
+            for (const Mode &mode: modes) {
+                runSequences(view, driver, seriesCount, points, mode, events);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Kernel benchmark suite: segment search and interpolation (the tracking
+// path of Methods and SplineSeries), point-to-segment distances, the
+// vectorized nearest-segment query and ZoomAndScroll::updateXLimits, over
+// sorted, reversed and noisy (jittered spacing) inputs from 1e3 points up.
+// Each result is printed as one JSON object per line on stdout, e.g.
+//   {"kernel":"trackLinear","input":"sorted","points":1000,"query":"sweep","ns_per_op":12.5,"ops":4096}
+// so runs can be diffed or loaded by a script; progress goes to stderr.
+// 1e8 points needs about 5 GB of memory.
+// Usage: kernelBench [max points] [min seconds per result]
+
+#include "customEvents.h"
+#include "segmentKernels.h"
+#include "trackKernels.h"
+#include <QApplication>
+#include <QLineSeries>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr qsizetype queryCount = 4096; // Cursor positions per run
+
+    enum class Input { Sorted, Reversed, Noisy };
+
+    const char *inputName(const Input input) {
+        switch (input) {
+            case Input::Sorted: return "sorted";
+            case Input::Reversed: return "reversed";
+            case Input::Noisy: return "noisy";
+        }
+        return "";
+    }
+
+    QList<QPointF> makePoints(const qsizetype count, const Input input) {
+        std::mt19937_64 random(count);
+        std::uniform_real_distribution<qreal> jitter(-0.05, 0.05);
+        QList<QPointF> points(count);
+        qreal x = 0;
+        for (qsizetype i = 0; i < count; ++i) {
+            const qreal y = std::sin(static_cast<qreal>(i) * 1e-3);
+            if (input == Input::Noisy) {
+                x += 0.1 + jitter(random);
+                points[i] = QPointF(x, y + jitter(random) * 10);
+            } else {
+                x = static_cast<qreal>(i) * 0.1;
+                points[i] = QPointF(input == Input::Reversed ? -x : x, y);
+            }
+        }
+        return points;
+    }
+
+    // Coherent sweep: a few segments per move, back and forth, like a cursor
+    std::vector<QPointF> sweepQueries(const QList<QPointF> &points) {
+        const qreal first = std::min(points.first().x(), points.last().x());
+        const qreal span = std::abs(points.last().x() - points.first().x());
+        std::vector<QPointF> queries(queryCount);
+        qreal x = span / 2;
+        qreal step = 0.37;
+        for (QPointF &query: queries) {
+            if (x + step < 0 || x + step > span) {
+                step = -step;
+            }
+            x += step;
+            query = QPointF(first + x, 0);
+        }
+        return queries;
+    }
+
+    // Uniform jumps across the whole range (no coherence to exploit)
+    std::vector<QPointF> randomQueries(const QList<QPointF> &points) {
+        std::mt19937_64 random(queryCount);
+        std::uniform_real_distribution<qreal> x(std::min(points.first().x(), points.last().x()),
+                                                std::max(points.first().x(), points.last().x()));
+        std::vector<QPointF> queries(queryCount);
+        for (QPointF &query: queries) {
+            query = QPointF(x(random), 0);
+        }
+        return queries;
+    }
+
+    class Suite {
+    public:
+        explicit Suite(const double minSeconds) : m_minSeconds(minSeconds) {
+        }
+
+        // Repeats run() until minSeconds have elapsed (at least twice) and
+        // reports the best run, divided by the operations it performed.
+        template<typename Run>
+        void measure(const char *kernel, const Input input, const qsizetype points, const char *query,
+                     const qsizetype ops, Run &&run) {
+            double best = std::numeric_limits<double>::infinity();
+            double total = 0;
+            for (int runs = 0; runs < 2 || total < m_minSeconds; ++runs) {
+                const auto start = Clock::now();
+                m_checksum += run();
+                const std::chrono::duration<double> elapsed = Clock::now() - start;
+                best = std::min(best, elapsed.count());
+                total += elapsed.count();
+            }
+            std::printf(R"({"kernel":"%s","input":"%s","points":%lld,"query":"%s","ns_per_op":%.3f,"ops":%lld})"
+                        "\n", kernel, inputName(input), static_cast<long long>(points), query,
+                        best * 1e9 / static_cast<double>(ops), static_cast<long long>(ops));
+            std::fflush(stdout);
+        }
+
+        [[nodiscard]] qreal checksum() const { return m_checksum; }
+
+    private:
+        double m_minSeconds;
+        qreal m_checksum = 0;
+    };
+
+    // Methods::findIntersection and SplineSeries::findIntersection both
+    // resolve to trackSegment with their interpolation policy.
+    template<typename Interpolation>
+    void benchTrack(Suite &suite, const char *kernel, const Input input, const QList<QPointF> &points) {
+        const auto run = [&points](const std::vector<QPointF> &queries, const bool coherent) {
+            qsizetype hint = -1;
+            qreal sum = 0;
+            for (const QPointF &query: queries) {
+                if (!coherent) {
+                    hint = -1;
+                }
+                const SegmentHit hit = trackSegment<Interpolation>(points.constData(), points.size(), query,
+                                                                   true, hint);
+                sum += hit.pos.y() + hit.distance;
+            }
+            return sum;
+        };
+        const std::vector<QPointF> sweep = sweepQueries(points);
+        const std::vector<QPointF> jumps = randomQueries(points);
+        suite.measure(kernel, input, points.size(), "sweep", queryCount, [&] { return run(sweep, true); });
+        suite.measure(kernel, input, points.size(), "random", queryCount, [&] { return run(jumps, false); });
+    }
+
+    void benchSeries(Suite &suite, const Input input, const qsizetype count) {
+        const QList<QPointF> points = makePoints(count, input);
+        const QPointF *data = points.constData();
+        const QPointF cursor = points[count / 2] + QPointF(0, 0.5);
+
+        benchTrack<LinearInterpolation>(suite, "trackLinear", input, points);
+        benchTrack<CatmullRomInterpolation>(suite, "trackCatmullRom", input, points);
+
+        // Whole-series passes: one operation per segment
+        suite.measure("segmentDistance", input, count, "all", count - 1, [&] {
+            qreal sum = 0;
+            for (qsizetype i = 0; i + 1 < count; ++i) {
+                sum += segmentDistance(cursor, data[i], data[i + 1]);
+            }
+            return sum;
+        });
+        suite.measure("catmullRomInterpolate", input, count, "all", count - 3, [&] {
+            qreal sum = 0;
+            for (qsizetype i = 1; i + 2 < count; ++i) {
+                sum += CatmullRomInterpolation::interpolate(0.5, data[i - 1], data[i], data[i + 1], data[i + 2]).y();
+            }
+            return sum;
+        });
+
+        {
+            std::vector<qreal> xs(count);
+            std::vector<qreal> ys(count);
+            for (qsizetype i = 0; i < count; ++i) {
+                xs[i] = data[i].x();
+                ys[i] = data[i].y();
+            }
+            const SegmentQuery query{cursor.x(), cursor.y()};
+            suite.measure("nearestSegment", input, count, "all", count - 1, [&] {
+                return nearestSegment(xs.data(), ys.data(), 0, count - 1, query).distanceSquared;
+            });
+            suite.measure("nearestSegmentScalar", input, count, "all", count - 1, [&] {
+                return nearestSegmentScalar(xs.data(), ys.data(), 0, count - 1, query).distanceSquared;
+            });
+        }
+
+        // Auto-range: point scan vs. bounds registered with setDataBounds()
+        auto *chart = new QChart();
+        ZoomAndScroll view(chart);
+        auto *series = new QLineSeries();
+        series->replace(points);
+        chart->addSeries(series);
+        suite.measure("updateXLimits", input, count, "scan", 1, [&] {
+            view.updateXLimits(chart);
+            return view.maxX - view.minX;
+        });
+        view.setDataBounds(series, QRectF(QPointF(view.minX, view.minY), QPointF(view.maxX, view.maxY)));
+        suite.measure("updateXLimits", input, count, "cached", 1, [&] {
+            view.updateXLimits(chart);
+            return view.maxX - view.minX;
+        });
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const qsizetype maxPoints = argc > 1 ? std::atoll(argv[1]) : 10'000'000;
+    const double minSeconds = argc > 2 ? std::atof(argv[2]) : 0.2;
+    if (maxPoints < 1000 || minSeconds < 0) {
+        std::fprintf(stderr, "usage: %s [max points >= 1000] [min seconds per result]\n", argv[0]);
+        return 1;
+    }
+
+    // ZoomAndScroll is a widget: headless unless told otherwise
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    int qtArgc = 1;
+    QApplication app(qtArgc, argv);
+
+    std::fprintf(stderr, "nearestSegment vectorized: %s\n", segmentKernelVectorized() ? "yes" : "no");
+    Suite suite(minSeconds);
+    for (qsizetype count = 1000; count <= maxPoints; count *= 10) {
+        for (const Input input: {Input::Sorted, Input::Reversed, Input::Noisy}) {
+            std::fprintf(stderr, "%lld points, %s\n", static_cast<long long>(count), inputName(input));
+            benchSeries(suite, input, count);
+        }
+    }
+    std::fprintf(stderr, "checksum: %g\n", suite.checksum());
+    return 0;
+}
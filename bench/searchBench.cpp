@@ -0,0 +1,85 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Segment search benchmark: full binary search vs. galloping search seeded
+// with the previous result, over a simulated (coherent) cursor sweep.
+// Usage: searchBench [points] [moves]
+
+#include "trackKernels.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Search>
+    double nsPerQuery(const std::vector<qreal> &cursor, Search &&search, qsizetype &checksum) {
+        const auto start = Clock::now();
+        for (const qreal x: cursor) {
+            checksum += search(x);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        return elapsed.count() / static_cast<double>(cursor.size());
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const qsizetype count = argc > 1 ? std::atoll(argv[1]) : 10'000'000;
+    const qsizetype moves = argc > 2 ? std::atoll(argv[2]) : 1'000'000;
+    if (count < 2 || moves < 1) {
+        std::fprintf(stderr, "usage: %s [points >= 2] [moves >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<QPointF> points(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        points[i] = QPointF(static_cast<qreal>(i) * 0.1, 0);
+    }
+
+    // Coherent sweep: a few segments per move, back and forth, like a cursor
+    std::vector<qreal> cursor(moves);
+    const qreal span = points.back().x();
+    qreal x = span / 2;
+    qreal step = 0.37;
+    for (qsizetype i = 0; i < moves; ++i) {
+        if (x + step < 0 || x + step > span) {
+            step = -step;
+        }
+        x += step;
+        cursor[i] = x;
+    }
+
+    qsizetype checksum = 0;
+    const double binary = nsPerQuery(cursor, [&](const qreal mouseX) {
+        return lowerBoundX(points.data(), count, mouseX);
+    }, checksum);
+
+    qsizetype hint = -1;
+    const double galloping = nsPerQuery(cursor, [&](const qreal mouseX) {
+        return trackSegment<LinearInterpolation>(points.data(), count, QPointF(mouseX, 0), false, hint).index;
+    }, checksum);
+
+    std::printf("points: %lld, moves: %lld\n", static_cast<long long>(count), static_cast<long long>(moves));
+    std::printf("binary search:    %8.2f ns/query\n", binary);
+    std::printf("galloping search: %8.2f ns/query (%.1fx)\n", galloping, binary / galloping);
+    std::printf("checksum: %lld\n", static_cast<long long>(checksum));
+    return 0;
+}
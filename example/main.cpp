@@ -1,12 +1,64 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <cstdio>
 
 #include "testWindow.h"
+#include "sessionRecorder.h"
+#include "traceRecorder.h"
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
+
+    // Interaction sessions: --record captures one, --replay plays it back
+    // (add QT_QPA_PLATFORM=offscreen to replay without a display)
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"record", "Record the interaction session to <file>.", "file"});
+    parser.addOption({"replay", "Replay the session in <file>, print its frame costs and quit.", "file"});
+    parser.addOption({"realtime", "Replay at the recorded pace instead of one frame per event."});
+    parser.addOption({"trace", "Trace the interaction pipeline and write it to <file> on exit.", "file"});
+    parser.process(app);
+
+    // Chrome/Perfetto trace of the last spans (ring buffer), written on exit
+    if (parser.isSet("trace")) {
+        TraceRecorder::instance().setEnabled(true);
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, [path = parser.value("trace")]() {
+            TraceRecorder::instance().setEnabled(false);
+            if (!TraceRecorder::instance().dump(path)) {
+                std::fprintf(stderr, "cannot write trace to %s\n", qPrintable(path));
+            }
+        });
+    }
+
     testWindow window;
     // window.resize(1024, 768);
     // window.show();
     window.showMaximized();
+
+    SessionRecorder recorder(window.chartView());
+    if (parser.isSet("record") && !recorder.start(parser.value("record"))) {
+        std::fprintf(stderr, "cannot record: %s\n", qPrintable(recorder.errorString()));
+        return 1;
+    }
+
+    SessionReplayer replayer;
+    if (parser.isSet("replay")) {
+        if (!replayer.load(parser.value("replay"))) {
+            std::fprintf(stderr, "cannot replay: %s\n", qPrintable(replayer.errorString()));
+            return 1;
+        }
+        const auto pacing = parser.isSet("realtime")
+                                ? SessionReplayer::Pacing::RealTime
+                                : SessionReplayer::Pacing::Deterministic;
+        QTimer::singleShot(0, &window, [&window, &replayer, pacing]() {
+            const SessionReplayer::Stats stats = replayer.replay(window.chartView(), pacing);
+            std::printf(R"({"events":%lld,"p50_ms":%.4f,"p90_ms":%.4f,"p99_ms":%.4f,"max_ms":%.4f,)"
+                        R"("total_ms":%.3f,"dropped_moves":%llu,"view_checks":%lld,"view_mismatches":%lld})"
+                        "\n", static_cast<long long>(stats.events), stats.p50Ms, stats.p90Ms, stats.p99Ms,
+                        stats.maxMs, stats.totalMs, static_cast<unsigned long long>(stats.droppedMoves),
+                        static_cast<long long>(stats.viewChecks), static_cast<long long>(stats.viewMismatches));
+            QCoreApplication::exit(stats.viewMismatches == 0 ? 0 : 1);
+        });
+    }
     return QApplication::exec();
 }
@@ -11,19 +11,27 @@ testWindow::testWindow(QWidget *parent)
     auto *series1 = new LineSeries(chartView);
     auto *series2 = new ScatterSeries(chartView);
     auto *series3 = new SplineSeries(chartView);
+    auto *series4 = new StepSeries(chartView); // Sample-and-hold (step-after)
     //*******************************************
 
     // Dense, steady plot
     constexpr int maxPoints = 10000;
+    QList<QPointF> acquired; // Decimated display, full-resolution tracking
+    acquired.reserve(2 * maxPoints);
     for (int i = -10000; i < maxPoints; ++i) {
         qreal j = i * 0.1;
-        series1->append(j, -1 * sin(j) * 5);
+        acquired.append(QPointF(j, -1 * sin(j) * 5));
         series2->append(j, cos(j) * 3 + 20);
         series3->append(j, sin(j * 0.5) * 4 + 30);
+        if (i % 10 == 0) {
+            series4->appendSample(j, sin(j * 0.2) > 0 ? -8 : -12);
+        }
     }
+    series1->setDecimatedData(acquired);
     chart->addSeries(series1);
     chart->addSeries(series2);
     chart->addSeries(series3);
+    chart->addSeries(series4);
 
     // Setting global chart limits
     chartView->updateXLimits(chart);
@@ -55,6 +63,11 @@ testWindow::testWindow(QWidget *parent)
     series3->setPen(shadowPen3);
     series3->setPointLabelsFormat("@xPoint, @yPoint");
     series3->setName("Predicted vibrations");
+    // -------------
+    QPen shadowPen4(Qt::darkMagenta);
+    shadowPen4.setWidth(2);
+    series4->setPen(shadowPen4);
+    series4->setName("Trigger state");
 
     // Chart axes setting
     chart->createDefaultAxes();
@@ -103,4 +116,5 @@ testWindow::testWindow(QWidget *parent)
     chart->legend()->setFont(QFont("Arial", 10));
 
     setCentralWidget(chartView);
+    m_chartView = chartView;
 }
@@ -2,6 +2,8 @@
 
 #include <QMainWindow>
 
+class ZoomAndScroll;
+
 class testWindow final : public QMainWindow {
     Q_OBJECT
 
@@ -9,4 +11,9 @@ public:
     explicit testWindow(QWidget *parent = nullptr);
 
     ~testWindow() override = default;
+
+    [[nodiscard]] ZoomAndScroll *chartView() const { return m_chartView; }
+
+private:
+    ZoomAndScroll *m_chartView{};
 };
@@ -0,0 +1,141 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Block-compressed storage for long recordings. Samples (ascending x) are
+// cut into blocks of blockSamples; each block keeps an uncompressed summary
+// (x span, min/max) and its samples compressed Gorilla-style: x as
+// delta-of-delta of its IEEE bit pattern (a uniform clock costs about one
+// bit per sample), y as the XOR with the previous value. Bounds and
+// zoomed-out views are answered from the summaries; only blocks that
+// intersect the visible range or the cursor are decompressed, and the
+// decoded ones are kept in a small LRU cache.
+//
+// Reads (view, lowerBound, mid, tracking) are thread-safe; append() is not.
+// Other threads (the tracking worker, exports) read a snapshot() instead,
+// so the store can keep growing on its own thread meanwhile.
+
+#include <QByteArray>
+#include <QCache>
+#include <QList>
+#include <QMutex>
+#include <QPointF>
+#include <QRectF>
+#include <memory>
+#include "trackKernels.h"
+
+class BlockStore {
+public:
+    static constexpr qsizetype blockSamples = 4096;
+
+    struct BlockSummary {
+        qsizetype first = 0; // Global index of the first sample
+        qsizetype count = 0;
+        qreal xFirst{};
+        qreal xLast{};
+        QPointF minPoint; // Lowest and highest sample of the block
+        QPointF maxPoint;
+    };
+
+    // cacheBytes: budget of the decoded-block cache
+    explicit BlockStore(qsizetype cacheBytes = 16 * 1024 * 1024);
+
+    // Appends ascending samples; every full block is compressed, the tail
+    // stays uncompressed until the block fills up.
+    void append(const QList<QPointF> &points);
+
+    [[nodiscard]] qsizetype size() const { return m_size; }
+
+    [[nodiscard]] qsizetype blockCount() const { return m_summaries.size(); }
+
+    [[nodiscard]] const BlockSummary &summary(const qsizetype block) const { return m_summaries[block]; }
+
+    // From the summaries only
+    [[nodiscard]] QRectF bounds() const;
+
+    // Compressed blocks plus the open tail, in bytes
+    [[nodiscard]] qsizetype storedBytes() const;
+
+    void setCacheLimit(qsizetype bytes);
+
+    [[nodiscard]] qsizetype cacheLimit() const;
+
+    [[nodiscard]] QPointF at(qsizetype i) const;
+
+    // First index whose x is not before value, in [0, size() - 1]
+    [[nodiscard]] qsizetype lowerBound(qreal value) const;
+
+    // Decoded copy of [from, from + n)
+    [[nodiscard]] QList<QPointF> mid(qsizetype from, qsizetype n) const;
+
+    // Points to draw [xMin, xMax] over the given pixel columns: blocks
+    // narrower than a column contribute their summary's min and max, the
+    // others are decompressed (min/max per column when dense). One block on
+    // each side is included so lines enter and leave the plot.
+    [[nodiscard]] QList<QPointF> view(qreal xMin, qreal xMax, int columns) const;
+
+    // Immutable copy of the current contents, O(1): the closed blocks, the
+    // summaries and the open tail are implicitly shared, and this store copies
+    // them on its next append. The copy has its own decoded-block cache.
+    [[nodiscard]] std::shared_ptr<const BlockStore> snapshot() const;
+
+private:
+    QList<BlockSummary> m_summaries; // Closed blocks, then the open one
+    QList<QByteArray> m_blocks; // Compressed closed blocks
+    QList<QPointF> m_open; // Tail block, uncompressed
+    qsizetype m_size = 0;
+
+    mutable QMutex m_mutex; // Guards the cache
+    mutable QCache<qsizetype, QList<QPointF>> m_cache; // Decoded blocks, cost in KiB
+
+    // Decoded samples of a block (the open block is returned as is)
+    [[nodiscard]] QList<QPointF> block(qsizetype index) const;
+
+    // Last block whose first x is not after value
+    [[nodiscard]] qsizetype blockAt(qreal value) const;
+
+    void closeBlock();
+};
+
+// Same search and policies as the QPointF overload, on the (at most four)
+// decoded samples the interpolation reads; only the block under the cursor
+// is decompressed.
+template<typename Interpolation>
+SegmentHit trackSegment(const BlockStore &store, const QPointF &chartPos, const bool withDistance,
+                        qsizetype &hint) {
+    const qsizetype count = store.size();
+    if (count < 2) {
+        return {};
+    }
+    const qsizetype idx = std::max<qsizetype>(0, store.lowerBound(chartPos.x()) - 1);
+    hint = idx;
+
+    const qsizetype first = std::max<qsizetype>(0, idx - 1);
+    const qsizetype last = std::min(count - 1, idx + 2);
+    const QList<QPointF> window = store.mid(first, last - first + 1);
+    qsizetype localHint = -1;
+    SegmentHit hit = trackSegment<Interpolation>(window.constData(), window.size(), chartPos, withDistance,
+                                                 localHint);
+    if (hit.isValid) {
+        hit.index += first;
+    }
+    return hit;
+}
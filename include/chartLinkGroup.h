@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QList>
+#include <QObject>
+#include "customEvents.h"
+
+// Views sharing one x (time) axis. A zoom, pan or reset in any member is
+// propagated to the others as one coalesced update per frame, and tracking
+// of the shared cursor x runs for every member's series in the scheduler's
+// batch of that frame, so the crosshairs of all views are drawn together.
+class ChartLinkGroup final : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ChartLinkGroup(QObject *parent = nullptr);
+
+    ~ChartLinkGroup() override;
+
+    // A view belongs to one group at most; adding it here removes it from
+    // its previous one. It adopts the group's current x range.
+    void addView(ZoomAndScroll *view);
+
+    void removeView(ZoomAndScroll *view);
+
+    [[nodiscard]] const QList<ZoomAndScroll *> &views() const { return m_views; }
+
+signals:
+    void xRangeChanged(qreal min, qreal max);
+
+private:
+    friend class ZoomAndScroll;
+
+    QList<ZoomAndScroll *> m_views;
+
+    // Range propagation: latest range wins, committed once per frame.
+    ZoomAndScroll *m_rangeSource = nullptr;
+    qreal m_rangeMin{};
+    qreal m_rangeMax{};
+    bool m_hasRange = false;
+
+    void requestXRange(ZoomAndScroll *source, qreal min, qreal max);
+
+    void commitXRange();
+
+    // Stages the shared cursor x in every member; the FrameScheduler runs
+    // them in its batch of this frame, with every other view's request.
+    void track(const ZoomAndScroll *source, const QPointF &chartPos, const QPointF &mousePos);
+
+    void hideTracking(const ZoomAndScroll *source) const;
+};
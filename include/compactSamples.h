@@ -0,0 +1,238 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Compact sample storage for long acquisitions. Instead of QPointF (two
+// doubles, 16 bytes per sample), x is either implicit (start + i * step, for
+// a uniform sample clock) or float32 relative to a double base, and y is
+// float32 relative to an offset or raw int16 ADC counts with a scale:
+// 2 to 8 bytes per sample. Tracking, bounds and decimation read the compact
+// form directly through visit(), which hands out an accessor specialized for
+// the encoding, so hot loops carry no per-sample branch. Samples are
+// ascending in x; storage is implicitly shared and immutable once built.
+
+#include <array>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include "trackKernels.h"
+
+class CompactSamples {
+public:
+    enum class XEncoding { Implicit, Float32 };
+    enum class YEncoding { Float32, Int16 };
+
+    // Decoding view of one encoding; x(), y() and lowerBound() inline fully.
+    template<XEncoding X, YEncoding Y>
+    struct Access {
+        const float *xs = nullptr;
+        const float *yf = nullptr;
+        const qint16 *yi = nullptr;
+        qreal x0{};
+        qreal step{};
+        qreal yScale = 1;
+        qreal yOffset{};
+        qsizetype count = 0;
+
+        [[nodiscard]] qsizetype size() const { return count; }
+
+        [[nodiscard]] qreal x(const qsizetype i) const {
+            if constexpr (X == XEncoding::Implicit) {
+                return x0 + static_cast<qreal>(i) * step;
+            } else {
+                return x0 + xs[i];
+            }
+        }
+
+        [[nodiscard]] qreal y(const qsizetype i) const {
+            if constexpr (Y == YEncoding::Float32) {
+                return yOffset + yf[i];
+            } else {
+                return yOffset + yScale * yi[i];
+            }
+        }
+
+        [[nodiscard]] QPointF at(const qsizetype i) const { return {x(i), y(i)}; }
+
+        // First index whose x is not before value, in [0, count - 1]
+        [[nodiscard]] qsizetype lowerBound(const qreal value) const {
+            if constexpr (X == XEncoding::Implicit) {
+                const qreal i = std::ceil((value - x0) / step);
+                return static_cast<qsizetype>(std::clamp<qreal>(i, 0, static_cast<qreal>(count - 1)));
+            } else {
+                return lowerBound(value, 0, count - 1);
+            }
+        }
+
+        // Same, galloping from hint (the last result, as gallopX does): cursor
+        // moves are coherent, so the answer is usually a few samples away.
+        [[nodiscard]] qsizetype lowerBound(const qreal value, qsizetype hint) const {
+            if constexpr (X == XEncoding::Implicit) {
+                return lowerBound(value);
+            } else {
+                const qsizetype last = count - 1;
+                hint = std::clamp<qsizetype>(hint, 0, last);
+                qsizetype left;
+                qsizetype right;
+                qsizetype stride = 1;
+                if (x(hint) < value) {
+                    // Answer is after hint: step right 1, 2, 4, ... until overshooting
+                    left = hint + 1;
+                    right = left;
+                    while (right < last && x(right) < value) {
+                        left = right + 1;
+                        right = std::min(last, right + stride);
+                        stride *= 2;
+                    }
+                } else {
+                    // Answer is at or before hint: step left until undershooting
+                    right = hint;
+                    left = hint;
+                    while (left > 0 && !(x(left - 1) < value)) {
+                        right = left - 1;
+                        left = std::max<qsizetype>(0, left - stride);
+                        stride *= 2;
+                    }
+                }
+                return lowerBound(value, std::min(left, last), std::min(right, last));
+            }
+        }
+
+        // Binary search on [left, right]
+        [[nodiscard]] qsizetype lowerBound(const qreal value, qsizetype left, qsizetype right) const {
+            while (left < right) {
+                const qsizetype mid = left + (right - left) / 2;
+                if (x(mid) < value) {
+                    left = mid + 1;
+                } else {
+                    right = mid;
+                }
+            }
+            return left;
+        }
+    };
+
+    CompactSamples() = default;
+
+    // Uniform sample clock, float32 values (stored as given).
+    static CompactSamples uniform(qreal x0, qreal step, const QList<float> &values);
+
+    // Uniform sample clock, raw ADC counts: y = offset + scale * raw.
+    static CompactSamples uniform(qreal x0, qreal step, const QList<qint16> &raw, qreal scale, qreal offset);
+
+    // Packs existing points (ascending x). A uniform x spacing is detected and
+    // stored implicitly; Int16 quantizes y over its range (65535 levels).
+    static CompactSamples fromPoints(const QList<QPointF> &points, YEncoding yEncoding = YEncoding::Float32);
+
+    [[nodiscard]] qsizetype size() const { return m_count; }
+
+    [[nodiscard]] bool isEmpty() const { return m_count == 0; }
+
+    [[nodiscard]] XEncoding xEncoding() const { return m_xEncoding; }
+
+    [[nodiscard]] YEncoding yEncoding() const { return m_yEncoding; }
+
+    [[nodiscard]] qreal x(qsizetype i) const;
+
+    [[nodiscard]] qreal y(qsizetype i) const;
+
+    [[nodiscard]] QPointF at(const qsizetype i) const { return {x(i), y(i)}; }
+
+    [[nodiscard]] qsizetype lowerBound(qreal value) const;
+
+    // Galloping from hint (a previous result), O(log distance)
+    [[nodiscard]] qsizetype lowerBound(qreal value, qsizetype hint) const;
+
+    // Decoded copy of [from, from + n)
+    [[nodiscard]] QList<QPointF> mid(qsizetype from, qsizetype n) const;
+
+    // Data bounds, kept from construction (no pass over the samples)
+    [[nodiscard]] QRectF bounds() const;
+
+    // Heap bytes of the encoded samples
+    [[nodiscard]] qsizetype bytes() const;
+
+    // Calls fn(access) with the accessor of this encoding; fn is instantiated
+    // once per encoding.
+    template<typename Fn>
+    decltype(auto) visit(Fn &&fn) const {
+        if (m_xEncoding == XEncoding::Implicit) {
+            if (m_yEncoding == YEncoding::Float32) {
+                return fn(access<XEncoding::Implicit, YEncoding::Float32>());
+            }
+            return fn(access<XEncoding::Implicit, YEncoding::Int16>());
+        }
+        if (m_yEncoding == YEncoding::Float32) {
+            return fn(access<XEncoding::Float32, YEncoding::Float32>());
+        }
+        return fn(access<XEncoding::Float32, YEncoding::Int16>());
+    }
+
+private:
+    XEncoding m_xEncoding = XEncoding::Implicit;
+    YEncoding m_yEncoding = YEncoding::Float32;
+    QList<float> m_xs; // Relative to m_x0 (Float32 x only)
+    QList<float> m_yf; // Relative to m_yOffset (Float32 y only)
+    QList<qint16> m_yi; // Raw counts (Int16 y only)
+    qreal m_x0{};
+    qreal m_step{};
+    qreal m_yScale = 1;
+    qreal m_yOffset{};
+    qreal m_yMin{};
+    qreal m_yMax{};
+    qsizetype m_count = 0;
+
+    template<XEncoding X, YEncoding Y>
+    [[nodiscard]] Access<X, Y> access() const {
+        return {m_xs.constData(), m_yf.constData(), m_yi.constData(), m_x0, m_step, m_yScale, m_yOffset, m_count};
+    }
+};
+
+// Same search and policies as the QPointF overload: the (at most four)
+// samples the interpolation reads are decoded into a small window.
+template<typename Interpolation>
+SegmentHit trackSegment(const CompactSamples &samples, const QPointF &chartPos, const bool withDistance,
+                        qsizetype &hint) {
+    const qsizetype count = samples.size();
+    if (count < 2) {
+        return {};
+    }
+    // Ascending x: O(1) for implicit x; over float32, a binary search or,
+    // with a hint, a gallop from it (same convention as the QPointF overload)
+    const qsizetype bound = hint < 0
+                                ? samples.lowerBound(chartPos.x())
+                                : samples.lowerBound(chartPos.x(), hint + 1);
+    const qsizetype idx = std::max<qsizetype>(0, bound - 1);
+    hint = idx;
+
+    const qsizetype first = std::max<qsizetype>(0, idx - 1);
+    const qsizetype last = std::min(count - 1, idx + 2);
+    std::array<QPointF, 4> window;
+    for (qsizetype i = first; i <= last; ++i) {
+        window[i - first] = samples.at(i);
+    }
+    qsizetype localHint = -1;
+    SegmentHit hit = trackSegment<Interpolation>(window.data(), last - first + 1, chartPos, withDistance, localHint);
+    if (hit.isValid) {
+        hit.index += first;
+    }
+    return hit;
+}
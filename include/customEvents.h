@@ -19,10 +19,16 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <chrono>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <span>
+#include <QCache>
+#include <QElapsedTimer>
 #include <QGraphicsDropShadowEffect>
 #include <QLabel>
+#include <QPixmap>
 #include <QSplineSeries>
 #include <QScatterSeries>
 #include <QTimer>
@@ -30,12 +36,55 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QtCharts/QChartView>
 #include <QXYSeries>
 #include <QFutureWatcher>
+#include <QHash>
+#include "blockStore.h"
+#include "compactSamples.h"
+#include "densityGrid.h"
+#include "latencyStats.h"
+#include "trackKernels.h"
+
+class ChartLinkGroup;
+class DatasetIndex;
+class QGraphicsPixmapItem;
+class ViewPrefetcher;
+
+// Visible axes ranges, passed by value along the tracking path (no heap).
+struct ViewLimits {
+    qreal xMin{};
+    qreal xMax{};
+    qreal yMin{};
+    qreal yMax{};
+
+    [[nodiscard]] bool contains(const QPointF &p) const {
+        return p.x() >= xMin && p.x() <= xMax && p.y() >= yMin && p.y() <= yMax;
+    }
+};
+
+// Hover (focus mode) hit-test request: cursor plus the current pixel scale,
+// so series measure their distance to it in pixels.
+struct HoverQuery {
+    QPointF chartPos;
+    QPointF mousePos;
+    qreal scaleX = 1; // Pixels per chart unit
+    qreal scaleY = 1;
+    qreal radius{}; // Pixels
+};
 
 struct TrackResult {
     qreal distance{};
     QPointF pos;
     QPointF IPpixel;
     bool isValid = false;
+    qint64 binCount = -1; // Density display: samples in the hovered bin
+};
+
+// Full data of one series, implicitly shared: safe to read off the GUI
+// thread while the series keeps changing (exports, offline analysis).
+struct SeriesSnapshot {
+    QString name;
+    QList<QPointF> points;
+    CompactSamples samples; // Compact storage (points empty)
+    std::shared_ptr<const BlockStore> blocks; // Block storage (points empty), a BlockStore::snapshot()
 };
 
 class ZoomAndScroll final : public QChartView {
@@ -44,24 +93,139 @@ class ZoomAndScroll final : public QChartView {
 public:
     explicit ZoomAndScroll(QChart *chart, QWidget *parent = nullptr);
 
+    ~ZoomAndScroll() override;
+
     // Batched, single-task tracking pipeline.
     // Worker-thread compute callback.
     // GUI-thread render callback.
     using TrackPrepareFn = std::function<void()>;
     using TrackComputeFn = std::function<TrackResult(const QPointF &, const QPointF &,
-                                                     const QVector<qreal> &, bool)>;
+                                                     const ViewLimits &, bool)>;
     using TrackRenderFn = std::function<void(const TrackResult &)>;
+    // GUI-thread hover hit-test (focus mode) and overlay hiding.
+    using TrackFocusFn = std::function<TrackResult(const HoverQuery &)>;
+    using TrackHideFn = std::function<void()>;
+    // GUI-thread snapshot of the series' full data.
+    using TrackSnapshotFn = std::function<SeriesSnapshot()>;
+    // GUI thread, from the view's destructor: release the overlays and forget the view.
+    using TrackDetachFn = std::function<void()>;
+
+    struct Tracker {
+        TrackPrepareFn prepare;
+        TrackComputeFn compute;
+        TrackRenderFn render;
+        TrackFocusFn focus;
+        TrackHideFn hide;
+        TrackSnapshotFn snapshot;
+        TrackDetachFn detach;
+    };
+
+    // The view dispatches every tracked series itself (no per-series signal
+    // fan-out). Returns the tracker's slot: a stable index into the per-frame tables.
+    // Takes part from the next tracking batch on; never waits for the worker.
+    int registerTracker(QXYSeries *series, Tracker tracker);
+
+    // The slot is emptied (the others keep their index) and reused by the next
+    // registration. Only waits if the batch in flight is computing this slot.
+    void unregisterTracker(int slot);
+
+    // Series report their overlays (lines/labels/bullet) state, so the
+    // dispatcher can skip series with nothing to hide.
+    // Overlay auto-hide: showing them restarts the slot's expiry, labels or
+    // not; once the timeout elapses without a restart, that series' overlays
+    // are hidden (and no other series' state is touched).
+    void overlaysShown(int slot);
+
+    void overlaysHidden(int slot);
+
+    // Shared by every tracked series (default 1000 ms).
+    void setLabelTimeout(int msec);
+
+    [[nodiscard]] int labelTimeout() const { return m_labelTimeout; }
+
+    // Zoom/pan history, walked with B/F (or the Back/Forward keys and mouse
+    // buttons). Each entry keeps its axis ranges; a rendered snapshot of the
+    // plot is cached too, under a memory cap (LRU), so stepping back shows the
+    // previous view at once while the chart re-renders on the next frame.
+    void setHistoryDepth(int entries);
+
+    [[nodiscard]] int historyDepth() const { return m_historyDepth; }
+
+    void setHistoryCacheLimit(qsizetype bytes);
+
+    [[nodiscard]] qsizetype historyCacheLimit() const;
+
+    bool historyBack();
+
+    bool historyForward();
+
+    void clearHistory();
+
+    // Mouse-move coalescing: only the latest move is handled, once per frame.
+    // Frames come from the process-wide FrameScheduler; its interval is shared
+    // by every view (FrameScheduler::setFrameInterval).
+
+    // Moves superseded by a newer one before their frame came up.
+    [[nodiscard]] quint64 droppedMoveEvents() const { return m_droppedMoves; }
+
+    // Interaction quality levels, from the richest to the cheapest one.
+    // CoarseDecimation draws decimated series one tile level coarser.
+    enum class Quality { Full, NoShadows, LinearTracking, NoLabels, CoarseDecimation };
+    Q_ENUM(Quality)
+
+    // Frame-time budget for the adaptive quality governor: when interaction
+    // frames keep running over it, quality is stepped down one level; it is
+    // restored as soon as the cursor rests. 0 (default) uses one frame
+    // interval (FrameScheduler::frameInterval) as budget, a negative value
+    // disables the governor.
+    void setFrameBudget(qreal msec);
+
+    [[nodiscard]] qreal frameBudget() const;
+
+    [[nodiscard]] Quality quality() const { return m_quality; }
+
+    // Focus mode: a series is hovered when one of its segments lies within
+    // this many pixels of the cursor (default 8).
+    void setHoverRadius(qreal pixels);
 
-    void registerTracker(TrackPrepareFn prepare, TrackComputeFn compute, TrackRenderFn render);
+    [[nodiscard]] qreal hoverRadius() const { return m_hoverRadius; }
+
+    // Latency instrumentation (off by default): every stage of the move,
+    // wheel and pan paths is timed into a histogram, a latencyReport() is
+    // emitted about once per second while the view repaints, and the HUD
+    // (H key) shows the frame rate and p99 end-to-end latency on the chart.
+    void setLatencyTracking(bool enabled);
+
+    [[nodiscard]] bool latencyTracking() const { return m_latencyEnabled; }
+
+    [[nodiscard]] const LatencyHistogram &latency(LatencyStage stage) const {
+        return m_latency[static_cast<int>(stage)];
+    }
+
+    void resetLatency();
+
+    // Showing the HUD turns the instrumentation on.
+    void setLatencyHud(bool visible);
+
+    [[nodiscard]] bool latencyHud() const { return m_hudVisible; }
 
 signals:
     void mouseMoved(QPointF mousePos,
-                    QMouseEvent *event,
-                    const QVector<qreal> &limits);
+                    QPointF globalPos,
+                    const ViewLimits &limits);
 
     void hideWhenMove();
 
+    void qualityChanged(ZoomAndScroll::Quality quality);
+
+    // Visible range changed (zoom, pan, linked view, history)
+    void viewChanged(const ViewLimits &limits);
+
+    void latencyReport(const LatencyReport &report);
+
 protected:
+    bool viewportEvent(QEvent *event) override;
+
     void mousePressEvent(QMouseEvent *event) override;
 
     void mouseMoveEvent(QMouseEvent *event) override;
@@ -74,27 +238,88 @@ protected:
 
     void keyPressEvent(QKeyEvent *event) override;
 
+    void drawForeground(QPainter *painter, const QRectF &rect) override;
+
 private:
     bool resizeHorZoom;
     bool resizeVerZoom;
     QPoint lastMousePos;
     QPoint rubberBandStartPos;
-    std::chrono::steady_clock::time_point lastEventTime{std::chrono::steady_clock::now()};
     QScopedPointer<QGraphicsRectItem> rubberBandItem;
-    QVector<qreal> limits{};
 
-    struct SeriesIntersection {
-        QXYSeries *series{};
-        QPointF point;
+    // Snapshot of the last mouse move, kept until its frame is processed.
+    struct PendingMove {
+        QPoint pos;
+        QPointF globalPos;
+        Qt::MouseButtons buttons;
     };
 
+    PendingMove m_pendingMove{};
+    bool m_hasPendingMove = false;
+    bool m_frameActive = false; // Receiving scheduler frames (cursor moving)
+    quint64 m_droppedMoves = 0;
+
+    // Quality governor state. The frame cost gathers every stage of an
+    // interaction frame (move handling, tracking batch, render, repaint).
+    Quality m_quality = Quality::Full;
+    qreal m_frameBudget = 0;
+    qint64 m_frameCostNs = 0;
+    int m_overBudgetFrames = 0;
+    QElapsedTimer m_batchClock;
+    QTimer *m_idleTimer{};
+
+    void setQuality(Quality quality);
+
+    void evaluateFrameCost();
+
+    // Called by the FrameScheduler; false once the view has gone idle.
+    bool onFrameTick();
+
+    friend class FrameScheduler;
+
+    void processMouseMove(const PendingMove &move);
+
     void clearRubberBand();
 
     void resetChartToOriginal() const;
 
+    // Zoom history. Entries are identified by a serial number, which keys the
+    // snapshot cache (cost in KiB).
+    struct HistoryEntry {
+        ViewLimits limits;
+        quint64 id = 0;
+    };
+
+    QList<HistoryEntry> m_history;
+    qsizetype m_historyIndex = -1;
+    int m_historyDepth = 50;
+    quint64 m_nextHistoryId = 0;
+    QCache<quint64, QPixmap> m_historyCache{64 * 1024};
+    QPixmap m_historySnapshot; // Painted over the plot until the ranges are applied
+    ViewLimits m_pendingHistoryLimits{};
+    bool m_historyApplyQueued = false;
+    bool m_historyGesturePending = false; // Pressed, not yet zooming or panning
+    QElapsedTimer m_lastWheelCommit;
+
+    void beginHistoryGesture();
+
+    // A press only arms the gesture; the view it starts from is recorded
+    // (and grabbed) once the press actually zooms or pans.
+    void beginPendingGesture();
+
+    void commitHistory(bool replaceTop = false);
+
+    void cacheHistorySnapshot();
+
+    bool goToHistory(qsizetype index);
+
+    void applyLimits(const ViewLimits &limits);
+
 public:
     void rangeUpdate();
 
+    [[nodiscard]] ViewLimits viewLimits() const { return {xMin, xMax, yMin, yMax}; }
+
     bool toggleState;
     bool toggleFocus;
     bool toggleLines;
@@ -109,27 +334,147 @@ public:
 
     void updateXLimits(const QChart *chart);
 
-    void updateIntersections(QXYSeries *series, const QPointF &point);
+    // Full data of a series (tracked series: what they track, not the
+    // decimated points they draw).
+    [[nodiscard]] SeriesSnapshot seriesSnapshot(const QXYSeries *series) const;
+
+    // Known data bounds of a series (e.g. from a DatasetIndex): used by
+    // updateXLimits() instead of scanning its points.
+    void setDataBounds(const QAbstractSeries *series, const QRectF &bounds);
+
+    // Its data was replaced: scan its points again.
+    void clearDataBounds(const QAbstractSeries *series);
+
+    // Slot of the bottom-most intersection of the last tracking batch (-1 if none).
+    [[nodiscard]] int bottomSlot() const { return m_bottomSlot; }
 
-    [[nodiscard]] QXYSeries *findBottomSeries() const;
+    // Link group this view belongs to (nullptr if none).
+    [[nodiscard]] ChartLinkGroup *linkGroup() const { return m_linkGroup; }
 
-    QList<SeriesIntersection> currentIntersections;
+    // Decimated-series display and prefetch (memory budget, hit/miss counters).
+    [[nodiscard]] ViewPrefetcher *prefetcher() const { return m_prefetcher; }
 
 private:
-    QList<TrackPrepareFn> m_prepareFns;
-    QList<TrackComputeFn> m_computeFns;
-    QList<TrackRenderFn> m_renderFns;
-    QFutureWatcher<QList<TrackResult> > *m_batchWatcher{};
+    // Tracked-series registry. The per-slot state scanned on every move is
+    // kept in flat arrays, apart from the (larger) callback records.
+    // Registering never waits for the worker: it reads m_batchTrackers, an
+    // implicitly shared copy taken by prepareBatch(), which the GUI thread
+    // detaches from when the registry changes (read both through at()).
+    QList<Tracker> m_trackers;
+    QList<Tracker> m_batchTrackers;
+    QList<QXYSeries *> m_trackedSeries;
+    QList<bool> m_overlaysShown;
+    // Sized by prepareBatch() to the batch's registry, never mid-batch.
+    QList<bool> m_slotActive; // Visible series of the batch being computed
+    // Written by the worker, read on the GUI thread once the batch finished.
+    QList<TrackResult> m_batchResults;
+    bool m_batchRunning = false; // Prepared, not finished yet
+
+    // Per-frame intersection table, indexed by tracker slot.
+    struct SlotIntersection {
+        QPointF point;
+        bool valid = false;
+    };
+
+    QList<SlotIntersection> m_intersections;
+    int m_bottomSlot = -1;
+
+    // Overlay expiry: intrusive FIFO of the slots with overlays on screen,
+    // ordered by deadline (uniform timeout), served by one single-shot timer.
+    struct ExpiryNode {
+        qint64 deadline = 0; // m_expiryClock msecs
+        int prev = -1;
+        int next = -1;
+        bool linked = false;
+    };
+
+    QList<ExpiryNode> m_expiry; // Indexed by tracker slot
+    int m_expiryHead = -1;
+    int m_expiryTail = -1;
+    int m_labelTimeout = 1000;
+    QElapsedTimer m_expiryClock;
+    QTimer *m_expiryTimer{};
+
+    void restartExpiry(int slot);
+
+    void unlinkExpiry(int slot);
+
+    void onExpiryTimeout();
+
+    // Tracking request staged for the scheduler's next batch (latest one
+    // wins); the active one is only read by the worker while it computes.
+    struct BatchRequest {
+        QPointF chartPos;
+        QPointF mousePos;
+        ViewLimits limits;
+        bool focusEnabled = false;
+    };
+
+    BatchRequest m_pendingBatch{};
+    bool m_hasPendingBatch = false;
+    BatchRequest m_activeBatch{};
 
     void runBatchTracking(const QPointF &chartPos, const QPointF &mousePos,
-                          const QVector<qreal> &limits, bool focusEnabled);
+                          const ViewLimits &limits, bool focusEnabled);
+
+    // Batch stages, driven by the FrameScheduler (link-group members included):
+    // prepare and finish on the GUI thread, compute on the worker.
+    void prepareBatch();
+
+    void computeBatch(const BatchRequest &request);
+
+    void finishBatch();
+
+    // Linked views (ChartLinkGroup)
+    friend class ChartLinkGroup;
+    // Session capture and replay save and restore the view state
+    friend class SessionRecorder;
+    friend class SessionReplayer;
+    ChartLinkGroup *m_linkGroup = nullptr;
+    ViewPrefetcher *m_prefetcher{};
+    QHash<const QAbstractSeries *, QRectF> m_dataBounds;
+    bool m_applyingLinkedRange = false;
+
+    void applyLinkedXRange(qreal min, qreal max);
+
+    QPointF m_lastFocusPos;
+    bool m_hasFocusPos = false;
+    qreal m_hoverRadius = 8;
+
+    void dispatchFocus(const QPointF &chartPos, const QPointF &mousePos, const QPointF &globalPos);
+
+    void hideTrackers();
+
+    // Latency stamps (0: none). The batch ones follow the tracking request
+    // from the move that staged it to the repaint showing its result.
+    bool m_latencyEnabled = false;
+    bool m_batchTimed = false; // Read by the worker for the batch in flight
+    bool m_hudVisible = false;
+    std::array<LatencyHistogram, static_cast<int>(LatencyStage::Count)> m_latency;
+    qint64 m_moveInputNs = 0; // Arrival of the pending move
+    qint64 m_batchInputNs = 0; // Input behind the staged batch
+    qint64 m_activeBatchInputNs = 0; // Input behind the batch in flight
+    qint64 m_batchDispatchNs = 0;
+    qint64 m_paintInputNs = 0; // Input waiting for its first repaint
+    quint64 m_reportPaints = 0;
+    bool m_hudRepaint = false; // Requested by the report alone: not a frame
+    QElapsedTimer m_reportClock;
+    QTimer *m_reportTimer{};
+    LatencyReport m_lastReport;
+
+    void recordLatency(LatencyStage stage, qint64 ns) {
+        m_latency[static_cast<int>(stage)].record(ns);
+    }
 
-    void onBatchFinished();
+    void emitLatencyReport();
+
+    void drawHud(QPainter *painter) const;
 };
 
 class LineSeries;
 class ScatterSeries;
 class SplineSeries;
+class StepSeries;
 
 template<typename SeriesType>
 class Methods {
@@ -138,13 +483,56 @@ public:
 
     virtual ~Methods();
 
+    // Large series: keeps the full data for tracking and lets the view draw a
+    // min/max decimation of it, prefetched around the current view (ascending
+    // x). Step series keep their stairs and are not decimated.
+    // An index of the same points (DatasetIndex, e.g. mapped from its
+    // sidecar) supplies the bounds, sortedness and first overview, so
+    // nothing is scanned on open. It must outlive the series.
+    void setDecimatedData(const QList<QPointF> &points, const DatasetIndex *index = nullptr);
+
+    // Same, from compact storage (implicit or float32 x, float32 or int16 y):
+    // tracking and decimation decode it in place, nothing is expanded to
+    // QPointF beyond what is drawn. Step series unpack it into their samples.
+    void setCompactData(const CompactSamples &samples);
+
+    // Block-compressed recordings: drawn from the block summaries, only the
+    // visible blocks are decompressed, and tracking decodes the block under
+    // the cursor. The store must outlive the series; the tracking worker
+    // reads a snapshot() of it, never the store itself.
+    void setBlockData(const BlockStore *store);
+
+    // Streaming: call after appending to the store (GUI thread). The visible
+    // range is redrawn; tracking moves to a snapshot of the new contents on
+    // its next batch. Step series unpack the store: set it again instead.
+    void blockDataAppended();
+
 protected:
+    // Label text is formatted in place into a fixed buffer (no QString per frame)
     struct TooltipData {
-        QString text;
+        std::array<char, 96> text{};
+        qsizetype length = -1;
         QPoint position;
         QColor color;
     };
 
+    // Reused every frame: x-axis, y-axis and intersection-point labels
+    std::array<TooltipData, 3> m_tooltipData;
+    // Last rendered intersection, labelled again when labels come back
+    QPointF m_lastIntersection;
+    // What each label currently displays, so unchanged ones are left untouched
+    QList<TooltipData> m_labelState;
+
+    // Text handed to each label, double-buffered: the label keeps a reference
+    // to the string it shows, so the other one is unshared and is refilled in
+    // place (no QString allocated per update).
+    struct LabelText {
+        std::array<QString, 2> buffers;
+        int shown = 0;
+    };
+
+    QList<LabelText> m_labelText;
+
     struct Intercerp {
         qreal distance{};
         QPointF pos;
@@ -152,10 +540,22 @@ protected:
         bool isValid = false;
     };
 
-    int m_tooltipTimeout = 1000;
+    int m_slot = -1; // Tracker slot in the view
+    // Set on the GUI thread from the view's quality, read by the tracking worker
+    std::atomic_bool m_linearTracking{false};
 
     QList<QPointF> m_points;
-    QTimer *tooltipTimer{};
+    QList<QPointF> m_fullData; // Decimated display only
+    bool m_hasFullData = false;
+    CompactSamples m_compactData; // Compact storage only (m_hasFullData set, m_fullData empty)
+    CompactSamples m_trackedSamples; // Worker's snapshot of m_compactData
+    const BlockStore *m_blockData{}; // Block storage only (m_hasFullData set)
+    std::shared_ptr<const BlockStore> m_trackedBlocks; // Worker's snapshot of m_blockData
+    const BlockStore *m_trackedBlocksSource{}; // Store it was taken from
+    // Last segment index, seeds the next search. One per caller thread:
+    // m_batchHint is only touched by the tracking worker, m_focusHint by the GUI.
+    qsizetype m_batchHint = -1;
+    qsizetype m_focusHint = -1;
     QGraphicsEllipseItem *bullet;
     QList<QLabel *> toolTips;
     QList<QGraphicsLineItem *> lines;
@@ -167,24 +567,55 @@ protected:
                                        const QPointF &lineStart,
                                        const QPointF &lineEnd);
 
-    virtual Intercerp findIntersection(const QList<QPointF> &points, bool focusEnabled,
-                                       const QPointF &chartPos, const QPointF &mousePos,
-                                       const QVector<qreal> &limits);
+    // Shared, inlined search; the interpolation policy comes from the series
+    // (SeriesType::withInterpolation), resolved at compile time.
+    template<typename Samples>
+    Intercerp findIntersection(const Samples &points, bool focusEnabled,
+                               const QPointF &chartPos, const QPointF &mousePos,
+                               const ViewLimits &limits, qsizetype &hint);
+
+    // The points tracked for this series (raw samples of step series, full
+    // data of decimated ones, drawn points otherwise), updated in place
+    void trackedPoints(QList<QPointF> &points) const;
+
+    void refreshSnapshot();
+
+    void displayBlocks();
 
     void renderTracking(const TrackResult &result);
 
     void registerBatchTracking();
 
-    void handleTooltipOnFocus(const QPointF &chartPos, const QMouseEvent *event);
+    void applyQuality(ZoomAndScroll::Quality quality);
+
+    void releaseOverlays();
+
+    TrackResult handleTooltipOnFocus(const HoverQuery &query);
+
+    // Hover geometry for the nearest-segment kernel: the drawn points, and
+    // their candidate window [m_segmentFirst, m_segmentLast] as
+    // structure-of-arrays (window-relative), reloaded when it moves.
+    static constexpr qsizetype maxHoverSegments = 1 << 16;
+    QList<QPointF> m_segmentSource;
+    QList<qreal> m_segmentXs;
+    QList<qreal> m_segmentYs;
+    qsizetype m_segmentFirst = -1;
+    qsizetype m_segmentLast = -1;
+    qsizetype m_hoverHint = -1;
+    QList<QPointF> m_focusPoints; // GUI thread's own copy of the tracked points
+
+    void refreshSegments();
+
+    void loadSegmentWindow(qsizetype first, qsizetype last);
 
     void createLines(int n);
 
     void updateVerticalLine(
-        const QPointF &mousePos, const QPointF &IPpixel, const QVector<qreal> &limits);
+        const QPointF &mousePos, const QPointF &IPpixel, const ViewLimits &limits);
 
     void setTooltips(const QPointF &intersectionPoint, const QPointF &IPpixel);
 
-    void createTooltips(const QList<TooltipData> &tooltipDataList);
+    void createTooltips(std::span<const TooltipData> tooltipDataList);
 
     void drawBullet(const QPointF &point);
 
@@ -199,14 +630,14 @@ class LineSeries final : public QLineSeries, public Methods<LineSeries> {
 public:
     explicit LineSeries(ZoomAndScroll *chartView, QObject *parent = nullptr);
 
+    template<typename Fn>
+    decltype(auto) withInterpolation(Fn &&fn) const {
+        return fn(LinearInterpolation{});
+    }
+
 public slots:
     void hideAll();
 
-private slots:
-    void onMouseMoved(QPointF mousePos,
-                      const QMouseEvent *event,
-                      const QVector<qreal> &limits);
-
 private:
     ZoomAndScroll *m_chartView;
 };
@@ -217,16 +648,68 @@ class ScatterSeries final : public QScatterSeries, public Methods<ScatterSeries>
 public:
     explicit ScatterSeries(ZoomAndScroll *chartView, QObject *parent = nullptr);
 
+    ~ScatterSeries() override;
+
+    template<typename Fn>
+    decltype(auto) withInterpolation(Fn &&fn) const {
+        return fn(LinearInterpolation{});
+    }
+
+    // Massive clouds: while more than markerLimit() points are visible, the
+    // series paints their density (one bin per plot pixel) instead of
+    // markers, and hover reports the bin count. Zoomed in below the limit,
+    // the visible points are drawn as markers again.
+    void setDensityData(const QList<QPointF> &points);
+
+    void setMarkerLimit(qsizetype points);
+
+    [[nodiscard]] qsizetype markerLimit() const { return m_markerLimit; }
+
+    [[nodiscard]] bool densityActive() const { return m_densityActive; }
+
+    [[nodiscard]] TrackResult densityHit(const HoverQuery &query) const;
+
 public slots:
     void hideAll();
 
-private slots:
-    void onMouseMoved(QPointF mousePos,
-                      const QMouseEvent *event,
-                      const QVector<qreal> &limits);
-
 private:
+    friend class Methods<ScatterSeries>;
+
+    // Binned off the GUI thread from a copy of the view state (the points
+    // are implicitly shared); the pixmap is swapped in once it is done.
+    struct DensityJob {
+        QList<QPointF> points;
+        ViewLimits limits{};
+        int width = 0;
+        int height = 0;
+        qsizetype markerLimit = 0;
+        // Results
+        DensityGrid grid;
+        QImage image;
+        QList<QPointF> markers;
+        bool active = false;
+    };
+
+    void updateDensity();
+
+    void dispatchDensity(DensityJob job);
+
+    void onDensityFinished();
+
+    // Removes the density item from the scene and deletes it (the scene
+    // must still be alive: called on destruction or when the view goes).
+    void releaseDensity();
+
     ZoomAndScroll *m_chartView;
+    QGraphicsPixmapItem *m_densityItem{};
+    DensityGrid m_density;
+    qsizetype m_markerLimit = 20000;
+    bool m_densityActive = false;
+    // One density job in flight; the latest view waits (latest wins).
+    QFutureWatcher<void> *m_densityWatcher{};
+    DensityJob m_densityJob;
+    DensityJob m_pendingDensityJob;
+    bool m_hasPendingDensityJob = false;
 };
 
 class SplineSeries final : public QSplineSeries, public Methods<SplineSeries> {
@@ -235,40 +718,58 @@ class SplineSeries final : public QSplineSeries, public Methods<SplineSeries> {
 public:
     explicit SplineSeries(ZoomAndScroll *chartView, QObject *parent = nullptr);
 
+    // Catmull-Rom, unless the quality governor asked for linear tracking
+    template<typename Fn>
+    decltype(auto) withInterpolation(Fn &&fn) const {
+        if (m_linearTracking.load(std::memory_order_relaxed)) {
+            return fn(LinearInterpolation{});
+        }
+        return fn(CatmullRomInterpolation{});
+    }
+
 public slots:
     void hideAll();
 
-private slots:
-    void onMouseMoved(QPointF mousePos,
-                      const QMouseEvent *event,
-                      const QVector<qreal> &limits);
+private:
+    ZoomAndScroll *m_chartView;
+};
+
+// Sampled digital channels: drawn as stairs, tracked on the raw samples.
+class StepSeries final : public QLineSeries, public Methods<StepSeries> {
+    Q_OBJECT
 
-protected:
-    Intercerp findIntersection(const QList<QPointF> &points, bool focusEnabled,
-                               const QPointF &chartPos, const QPointF &mousePos,
-                               const QVector<qreal> &limits) override;
+public:
+    explicit StepSeries(ZoomAndScroll *chartView, StepMode mode = StepMode::After,
+                        QObject *parent = nullptr);
+
+    [[nodiscard]] StepMode stepMode() const { return m_mode; }
+
+    // Samples go through these (not append/replace), so the stairs get built.
+    void appendSample(qreal x, qreal y);
+
+    void setSamples(const QList<QPointF> &samples);
+
+    [[nodiscard]] const QList<QPointF> &samples() const { return m_samples; }
+
+    template<typename Fn>
+    decltype(auto) withInterpolation(Fn &&fn) const {
+        switch (m_mode) {
+            case StepMode::Before:
+                return fn(StepBeforeInterpolation{});
+            case StepMode::Center:
+                return fn(StepCenterInterpolation{});
+            default:
+                return fn(StepAfterInterpolation{});
+        }
+    }
+
+public slots:
+    void hideAll();
 
 private:
     ZoomAndScroll *m_chartView;
+    StepMode m_mode;
+    QList<QPointF> m_samples;
 
-    static constexpr qreal T = 1; // Catmull-Rom tension parameter
-
-    static QPointF catmullRomInterpolate(const qreal t,
-                                         const QPointF &p0,
-                                         const QPointF &p1,
-                                         const QPointF &p2,
-                                         const QPointF &p3) {
-        const qreal t2 = t * t;
-        const qreal t3 = t2 * t;
-
-        const qreal h1 = -T * t3 + 2 * T * t2 - T * t;
-        const qreal h2 = (2 - T) * t3 + (T - 3) * t2 + 1;
-        const qreal h3 = (T - 2) * t3 + (3 - 2 * T) * t2 + T * t;
-        const qreal h4 = T * t3 - T * t2;
-
-        return {
-            h1 * p0.x() + h2 * p1.x() + h3 * p2.x() + h4 * p3.x(),
-            h1 * p0.y() + h2 * p1.y() + h3 * p2.y() + h4 * p3.y()
-        };
-    }
+    void appendStair(const QPointF &from, const QPointF &to, QList<QPointF> &out) const;
 };
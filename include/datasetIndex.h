@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Derived structures of a large dataset, cached on disk next to it: bounds,
+// x sortedness, a min/max pyramid over fixed sample buckets (which doubles
+// as an interval index on x) and per-bucket prefix sums of y. The sidecar
+// is versioned and keyed by the data's identity (see the keys below); on
+// the next open it is memory-mapped and used as is, so nothing is rescanned.
+
+#include <span>
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+
+class DatasetIndex final {
+public:
+    static constexpr quint32 formatVersion = 1;
+    static constexpr qint64 baseBucketSamples = 256;
+    static constexpr int maxLevels = 48;
+    static constexpr qsizetype keySamples = 1024; // Points hashed by sampledKey()
+
+    // One pyramid bucket; layout shared with the file (native byte order)
+    struct Bucket {
+        qreal xFirst{};
+        qreal xLast{};
+        QPointF minPoint; // Lowest and highest sample of the bucket
+        QPointF maxPoint;
+    };
+
+    DatasetIndex();
+
+    ~DatasetIndex();
+
+    // Keys, all BLAKE2b-256. Reopening must stay cheap, so the default ones
+    // do not read every point:
+    // - sampledKey: the count and keySamples evenly spaced points (O(1) in N);
+    // - fileKey: the data file's path, size and modification time, plus the
+    //   sampled key of the points loaded from it (the usual choice);
+    // - contentKey: every point, O(N); opt-in, when an edit between the
+    //   sampled points must invalidate the sidecar.
+    // Callers with their own stable identity (acquisition id) can pass it instead.
+    static QByteArray sampledKey(const QList<QPointF> &points);
+
+    static QByteArray fileKey(const QString &dataPath, const QList<QPointF> &points);
+
+    static QByteArray contentKey(const QList<QPointF> &points);
+
+    // Maps the sidecar if it matches the key (sampledKey() if empty),
+    // otherwise builds the index from the points and writes the sidecar.
+    // False only if no index could be built.
+    bool open(const QString &sidecarPath, const QList<QPointF> &points, const QByteArray &key = {});
+
+    // Maps an existing sidecar; false if missing, stale or of another version.
+    bool load(const QString &sidecarPath, const QByteArray &key);
+
+    void build(const QList<QPointF> &points, const QByteArray &key);
+
+    bool save(const QString &sidecarPath) const;
+
+    [[nodiscard]] bool isValid() const { return m_data != nullptr; }
+
+    // Whether the last open() used the sidecar instead of rebuilding
+    [[nodiscard]] bool isMapped() const { return m_mapped != nullptr; }
+
+    [[nodiscard]] qint64 count() const;
+
+    [[nodiscard]] bool ascending() const;
+
+    [[nodiscard]] QRectF bounds() const;
+
+    [[nodiscard]] int levels() const;
+
+    // Buckets of a level; level L covers baseBucketSamples << L samples each
+    [[nodiscard]] std::span<const Bucket> level(int level) const;
+
+    // Sum of y over level-0 buckets [first, last)
+    [[nodiscard]] qreal bucketSum(qint64 first, qint64 last) const;
+
+    // Min/max outline of [xMin, xMax] over the given columns, read from the
+    // pyramid only (ascending x; one bucket beyond each edge).
+    [[nodiscard]] QList<QPointF> overview(qreal xMin, qreal xMax, int columns) const;
+
+private:
+    struct Header;
+
+    QByteArray m_built; // Built in memory
+    QFile m_file; // Or mapped from the sidecar
+    uchar *m_mapped = nullptr;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+
+    [[nodiscard]] const Header &header() const;
+
+    void unmap();
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Min/max decimation over aligned tiles. A series' x span is divided into
+// levels of detail: level L has columns 2^L base columns wide, and its
+// columns are grouped in fixed tiles, so any view at any zoom or pan offset
+// is assembled from tiles that can be computed (and cached) ahead of time.
+
+#include <QList>
+#include <QPointF>
+
+class CompactSamples;
+
+// Geometry of one decimated series (ascending x).
+struct DecimationGrid {
+    qreal x0{}; // First sample x
+    qreal baseWidth{}; // Column width at level 0
+
+    static constexpr int baseColumns = 1 << 20; // Level-0 columns over the whole span
+    static constexpr int tileColumns = 512;
+
+    [[nodiscard]] bool isValid() const { return baseWidth > 0; }
+
+    [[nodiscard]] qreal columnWidth(int level) const;
+
+    [[nodiscard]] qreal tileWidth(int level) const { return columnWidth(level) * tileColumns; }
+
+    [[nodiscard]] qint64 tileAt(int level, qreal x) const;
+
+    // Coarsest level whose columns are not wider than wanted
+    [[nodiscard]] int levelFor(qreal wantedColumnWidth) const;
+
+    static DecimationGrid forPoints(const QList<QPointF> &points);
+
+    static DecimationGrid forSamples(const CompactSamples &samples);
+};
+
+struct VisibleStats {
+    qsizetype count = 0;
+    qreal yMin{};
+    qreal yMax{};
+    qreal sum{};
+
+    void merge(const VisibleStats &other);
+
+    [[nodiscard]] qreal mean() const { return count > 0 ? sum / static_cast<qreal>(count) : 0; }
+};
+
+struct DecimationTile {
+    QList<QPointF> points; // Min and max of every non-empty column, in x order
+    VisibleStats stats;
+
+    [[nodiscard]] qsizetype bytes() const {
+        return static_cast<qsizetype>(sizeof(DecimationTile)) + points.size() * static_cast<qsizetype>(sizeof(QPointF));
+    }
+};
+
+// Pure and thread-safe: used on the GUI thread (cache misses) and by the prefetcher.
+DecimationTile decimateTile(const QPointF *points, qsizetype count, const DecimationGrid &grid,
+                            int level, qint64 tileIndex);
+
+// Same, decoding compact samples in place.
+DecimationTile decimateTile(const CompactSamples &samples, const DecimationGrid &grid, int level, qint64 tileIndex);
+
+// Whole-series overview with about `columns` columns (initial display).
+QList<QPointF> decimateOverview(const QList<QPointF> &points, int columns);
@@ -0,0 +1,60 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Density (2D histogram) of a point cloud over the visible range, one bin
+// per plot pixel, for scatter series too large to draw marker by marker.
+
+#include <QImage>
+#include <QList>
+#include <QPointF>
+
+struct DensityGrid {
+    // Visible range the bins cover, row 0 at the top (yMax)
+    qreal xMin{};
+    qreal xMax{};
+    qreal yMin{};
+    qreal yMax{};
+    int width = 0;
+    int height = 0;
+    QList<quint32> counts; // width * height, row-major
+    quint32 maxCount = 0;
+    qsizetype total = 0; // Samples inside the range
+
+    [[nodiscard]] bool isEmpty() const { return counts.isEmpty(); }
+
+    // Bin under a chart value (0 outside the range)
+    [[nodiscard]] quint32 countAt(const QPointF &value) const;
+
+    [[nodiscard]] QPointF binCenter(const QPointF &value) const;
+};
+
+// Bins the points in parallel (one partial histogram per worker, summed at
+// the end); the inner loop computes bin indices branch-free, in blocks, so
+// the compiler can vectorize it.
+DensityGrid binDensity(const QList<QPointF> &points, qreal xMin, qreal xMax, qreal yMin, qreal yMax,
+                       int width, int height);
+
+// Log-scaled color map; empty bins are transparent.
+QImage densityImage(const DensityGrid &grid);
+
+// Points inside the range, for the marker fallback.
+QList<QPointF> pointsInRange(const QList<QPointF> &points, qreal xMin, qreal xMax, qreal yMin, qreal yMax);
@@ -0,0 +1,131 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <functional>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QWaitCondition>
+
+class QThread;
+class ZoomAndScroll;
+
+// Process-wide frame clock shared by every ZoomAndScroll. One precise timer
+// ticks once per display frame while any view has work; each tick handles
+// the posted one-off tasks (e.g. linked axis commits), then every active
+// view's latest mouse move, and finally runs all the tracking requests
+// staged by those views as one batch on a persistent worker thread.
+class FrameScheduler final : public QObject {
+    Q_OBJECT
+
+public:
+    // Idle views get no frames at all (e.g. on a hidden tab); Low ones are
+    // served every other frame. Hidden or fully obscured views are skipped
+    // whatever their priority.
+    enum class Priority { Idle, Low, Normal, High };
+    Q_ENUM(Priority)
+
+    // Created on first use, owned by the application object. GUI thread only.
+    static FrameScheduler *instance();
+
+    ~FrameScheduler() override;
+
+    void registerView(ZoomAndScroll *view);
+
+    void unregisterView(ZoomAndScroll *view);
+
+    void setPriority(ZoomAndScroll *view, Priority priority);
+
+    [[nodiscard]] Priority priority(const ZoomAndScroll *view) const;
+
+    // The view has work: keep ticking for it until it reports idle.
+    void requestFrames(ZoomAndScroll *view);
+
+    // One-off task for the next frame. A newer task from the same owner
+    // replaces the pending one; tasks of destroyed owners are dropped.
+    void post(QObject *owner, std::function<void()> task);
+
+    // 0 (default) follows the primary screen refresh rate.
+    void setFrameInterval(int msec);
+
+    [[nodiscard]] int frameInterval() const;
+
+    [[nodiscard]] quint64 frameCount() const { return m_frameCount; }
+
+    // Blocks until the tracking batch in flight (if any) is done.
+    void waitForBatch() const;
+
+signals:
+    // Every view of the last tracking batch has rendered its results.
+    void batchFinished();
+
+protected:
+    void customEvent(QEvent *event) override;
+
+private:
+    explicit FrameScheduler(QObject *parent = nullptr);
+
+    struct ViewEntry {
+        ZoomAndScroll *view = nullptr;
+        Priority priority = Priority::Normal;
+        bool active = false; // Requested frames
+    };
+
+    struct Task {
+        QPointer<QObject> owner;
+        std::function<void()> run;
+    };
+
+    QList<ViewEntry> m_views; // Sorted by priority, highest first
+    QList<Task> m_tasks;
+    QList<Task> m_runningTasks; // Swapped with m_tasks on each tick
+    QTimer *m_timer{};
+    int m_frameInterval = 0;
+    quint64 m_frameCount = 0;
+
+    // Shared tracking batch: every view staged in this frame. It runs on one
+    // worker thread kept for the scheduler's lifetime, so dispatching a
+    // batch starts no task or future; completion is one posted event.
+    QList<ZoomAndScroll *> m_batchViews;
+    bool m_batchInFlight = false; // GUI thread: dispatched, not finished yet
+    QThread *m_worker{};
+    mutable QMutex m_workerMutex;
+    QWaitCondition m_workerWake;
+    mutable QWaitCondition m_batchDone;
+    bool m_batchQueued = false; // Guarded by m_workerMutex
+    bool m_stopWorker = false;
+
+    void runWorker();
+
+    void ensureTicking();
+
+    void tick();
+
+    void dispatchTracking();
+
+    void onBatchFinished();
+
+    void sortViews();
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Interaction latency instrumentation. Each stage of the move, wheel and pan
+// paths records its duration into a lock-free log-linear histogram (4
+// buckets per power of two, about 19% wide), from the GUI thread or the
+// tracking worker alike; percentiles are read back on demand.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <QtGlobal>
+
+// Monotonic timestamp for stage boundaries
+inline qint64 latencyNow() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class LatencyHistogram {
+public:
+    static constexpr int bucketCount = 256;
+
+    // Any thread; relaxed atomics only
+    void record(const qint64 ns) noexcept {
+        const auto value = static_cast<quint64>(std::max<qint64>(0, ns));
+        m_buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        quint64 max = m_max.load(std::memory_order_relaxed);
+        while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() noexcept;
+
+    [[nodiscard]] quint64 count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] qint64 maximum() const noexcept {
+        return static_cast<qint64>(m_max.load(std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] qint64 mean() const noexcept;
+
+    // Upper bound of the bucket holding the p-quantile (0 < p <= 1), in ns;
+    // 0 while empty.
+    [[nodiscard]] qint64 percentile(double p) const noexcept;
+
+    // Values v < 4 get their own bucket; above, [2^e, 2^(e+1)) is split in four.
+    static constexpr int bucketOf(const quint64 value) noexcept {
+        if (value < 4) {
+            return static_cast<int>(value);
+        }
+        const int e = std::bit_width(value) - 1;
+        return 4 * (e - 1) + static_cast<int>((value >> (e - 2)) & 3);
+    }
+
+    static constexpr quint64 bucketUpperBound(const int bucket) noexcept {
+        if (bucket < 4) {
+            return static_cast<quint64>(bucket);
+        }
+        const int e = bucket / 4 + 1;
+        const quint64 width = quint64{1} << (e - 2);
+        return (static_cast<quint64>(4 + bucket % 4) << (e - 2)) + width - 1;
+    }
+
+private:
+    std::array<std::atomic<quint64>, bucketCount> m_buckets{};
+    std::atomic<quint64> m_count{0};
+    std::atomic<quint64> m_sum{0};
+    std::atomic<quint64> m_max{0};
+};
+
+// Stages timed by ZoomAndScroll (see setLatencyTracking)
+enum class LatencyStage {
+    InputQueue, // Mouse move received -> handled by its frame
+    MoveHandling, // Frame's move handling (no button held)
+    Pan, // Frame's move handling while right-drag panning
+    Wheel, // Wheel zoom handler
+    BatchQueue, // Tracking batch dispatched -> picked up by the worker
+    Compute, // Every tracked series' compute callback, on the worker
+    Render, // Batch results rendered on the GUI thread
+    Paint, // Viewport repaint
+    EndToEnd, // Input received -> first repaint showing its result
+    Count
+};
+
+const char *latencyStageName(LatencyStage stage);
+
+// Periodic summary (about once per second while the view is repainting)
+struct LatencyReport {
+    qreal fps{}; // Repaints per second over the report period
+    std::array<qint64, static_cast<int>(LatencyStage::Count)> p50Ns{};
+    std::array<qint64, static_cast<int>(LatencyStage::Count)> p99Ns{};
+};
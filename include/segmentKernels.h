@@ -0,0 +1,54 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Nearest-segment queries for hover (focus mode). Points are kept as
+// structure-of-arrays (x[], y[]) so many segments are evaluated per call;
+// an AVX2 kernel is selected at runtime when the CPU supports it, with a
+// portable scalar fallback otherwise.
+
+#include <limits>
+#include <QtGlobal>
+
+struct SegmentQuery {
+    qreal x{}; // Cursor, in chart values
+    qreal y{};
+    qreal scaleX = 1; // Pixels per chart unit, so distances come out in pixels
+    qreal scaleY = 1;
+};
+
+struct NearestSegment {
+    qsizetype index = -1; // Segment [index, index + 1]
+    qreal distanceSquared = std::numeric_limits<qreal>::infinity(); // Pixels^2
+    qreal t{}; // Clamped projection parameter on the segment
+};
+
+// Nearest of the segments [i, i + 1], first <= i < last (last <= count - 1).
+// Uses the fastest kernel available on this CPU.
+NearestSegment nearestSegment(const qreal *xs, const qreal *ys, qsizetype first, qsizetype last,
+                              const SegmentQuery &query);
+
+// Reference implementation, always available.
+NearestSegment nearestSegmentScalar(const qreal *xs, const qreal *ys, qsizetype first, qsizetype last,
+                                    const SegmentQuery &query);
+
+// Whether nearestSegment() runs the vectorized kernel on this machine.
+bool segmentKernelVectorized();
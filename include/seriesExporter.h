@@ -0,0 +1,64 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// Streams series data to disk on a worker thread, from immutable snapshots
+// taken when the export starts, so the GUI keeps running and the series may
+// change meanwhile. CSV is one "series,x,y" row per sample; the binary
+// format is columnar (all x, then all y, per series) and little-endian, and
+// each chunk is decoded once into both columns. Writes are chunked and
+// buffered, progress is reported in permille and an export can be canceled,
+// in which case the target file is left untouched.
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include "customEvents.h"
+
+class SeriesExporter final : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Format { Csv, Binary };
+    enum class Range { Visible, Full };
+
+    explicit SeriesExporter(ZoomAndScroll *view, QObject *parent = nullptr);
+
+    ~SeriesExporter() override;
+
+    // Starts exporting; false if an export is already running. Visible
+    // exports the view's current x range (xMin..xMax) of each series.
+    bool start(const QString &path, const QList<QXYSeries *> &series, Format format, Range range);
+
+    void cancel();
+
+    [[nodiscard]] bool isRunning() const;
+
+signals:
+    void progress(int permille);
+
+    // error is empty on success
+    void finished(bool success, const QString &error);
+
+private:
+    ZoomAndScroll *m_view;
+    QFutureWatcher<QString> *m_watcher{};
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Interaction sessions: the input a ZoomAndScroll receives (mouse, wheel and
+// key events, timestamped) and its visible ranges, recorded to a compact
+// binary file from the live view, then fed back through the same event
+// handlers. Replay runs with or without a display (offscreen platform) and
+// times every event from delivery until it is handled and painted, so a
+// captured slow session becomes a repeatable benchmark.
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include "customEvents.h"
+
+class QDataStream;
+
+// One recorded input event or view state
+struct SessionRecord {
+    enum class Kind : quint8 { Mouse, Wheel, Key, Resize, View };
+
+    Kind kind = Kind::Mouse;
+    qint64 timeUs = 0; // Since the recording started
+    quint16 type = 0; // QEvent::Type (mouse and key events)
+    QPointF pos; // Viewport position (mouse, wheel)
+    quint32 button = 0; // Mouse button, key code or wheel angle delta
+    quint32 buttons = 0;
+    quint32 modifiers = 0;
+    QSize size; // Resize
+    ViewLimits limits; // View
+};
+
+// File layout: header (magic "TPSR", version, viewport size, view limits,
+// view flags), then the records; each stores its time as a delta to the
+// previous one (microseconds) and positions in 1/256 pixel.
+class SessionRecorder final : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr quint32 formatVersion = 1;
+
+    explicit SessionRecorder(ZoomAndScroll *view, QObject *parent = nullptr);
+
+    ~SessionRecorder() override;
+
+    // Starts recording into path (truncated), from the view's current state.
+    bool start(const QString &path);
+
+    void stop();
+
+    [[nodiscard]] bool isRecording() const { return m_file.isOpen(); }
+
+    [[nodiscard]] QString errorString() const { return m_file.errorString(); }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    ZoomAndScroll *m_view;
+    QFile m_file;
+    QDataStream *m_stream{};
+    QElapsedTimer m_clock;
+    qint64 m_lastUs = 0;
+    QMetaObject::Connection m_viewConnection;
+
+    void write(SessionRecord record);
+};
+
+class SessionReplayer final : public QObject {
+    Q_OBJECT
+
+public:
+    // Deterministic: each event is delivered to an idle view, once the
+    // previous one is fully handled (every move gets its own frame, the
+    // recorded times are ignored). RealTime: events are delivered at their
+    // recorded times, so moves coalesce as they did live.
+    enum class Pacing { Deterministic, RealTime };
+
+    struct Stats {
+        qsizetype events = 0; // Input events delivered
+        qsizetype viewChecks = 0; // Recorded view states compared (deterministic)
+        qsizetype viewMismatches = 0;
+        quint64 droppedMoves = 0; // Coalesced by the view
+        // Delivery to handled and painted, per timed event (real time: the
+        // events handled before the next one was due)
+        double p50Ms = 0;
+        double p90Ms = 0;
+        double p99Ms = 0;
+        double maxMs = 0;
+        double totalMs = 0;
+    };
+
+    explicit SessionReplayer(QObject *parent = nullptr);
+
+    ~SessionReplayer() override;
+
+    bool load(const QString &path);
+
+    [[nodiscard]] QString errorString() const { return m_error; }
+
+    [[nodiscard]] const QList<SessionRecord> &records() const { return m_records; }
+
+    // Restores the recorded starting state of the view (ranges, toggles,
+    // empty history) and replays the session, pumping the event loop until
+    // the last event is handled. Positions are scaled if the viewport size
+    // differs from the recorded one (top-level views are resized to it).
+    // Idle views are replayed at Normal priority, then restored.
+    Stats replay(ZoomAndScroll *view, Pacing pacing = Pacing::Deterministic);
+
+private:
+    QSize m_viewportSize;
+    ViewLimits m_limits{};
+    quint8 m_flags = 0;
+    QList<SessionRecord> m_records;
+    QString m_error;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+// Opt-in tracing of the interaction pipeline. Scoped spans (name, thread,
+// begin/end, optional integer argument such as a tracker slot) go into a
+// fixed ring buffer shared by every thread, the oldest ones being
+// overwritten, and are dumped on demand as Chrome/Perfetto trace-event JSON
+// (chrome://tracing, ui.perfetto.dev). Disabled, a span costs one relaxed
+// atomic load.
+
+#include <atomic>
+#include <memory>
+#include <QString>
+#include "latencyStats.h"
+
+class TraceRecorder {
+public:
+    static constexpr qsizetype defaultCapacity = 1 << 16;
+
+    static TraceRecorder &instance();
+
+    [[nodiscard]] static bool enabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+    void setEnabled(bool enabled);
+
+    // Events kept (rounded up to a power of two). Like clear(), it pauses
+    // recording and waits for the writers in flight before touching the
+    // buffer; spans ending meanwhile are dropped. Same thread as toJson().
+    void setCapacity(qsizetype events);
+
+    [[nodiscard]] qsizetype capacity() const { return m_mask + 1; }
+
+    void clear();
+
+    // Name must be a string literal (stored by pointer). Any thread; a no-op
+    // while disabled (spans begun before disabling end here too).
+    void record(const char *name, qint64 beginNs, qint64 endNs, qint64 arg = -1) noexcept;
+
+    // Trace-event JSON of the buffered spans, oldest first.
+    [[nodiscard]] QByteArray toJson() const;
+
+    bool dump(const QString &path) const;
+
+private:
+    TraceRecorder();
+
+    struct Slot {
+        std::atomic<quint64> sequence{0}; // Ticket + 1 once written, 0 while writing
+        std::atomic<const char *> name{nullptr};
+        std::atomic<qint64> begin{0};
+        std::atomic<qint64> end{0};
+        std::atomic<qint64> arg{-1};
+        std::atomic<int> thread{0};
+    };
+
+    static inline std::atomic<bool> s_enabled{false};
+
+    std::unique_ptr<Slot[]> m_slots;
+    qsizetype m_mask = 0;
+    std::atomic<quint64> m_next{0};
+    std::atomic<int> m_writers{0}; // record() calls past the enabled check
+
+    // Turns recording off and waits until no writer is left; returns the previous state
+    bool pause();
+};
+
+// Records its scope as one span when tracing is on.
+class TraceSpan {
+public:
+    explicit TraceSpan(const char *name, const qint64 arg = -1) noexcept
+        : m_name(name)
+          , m_arg(arg)
+          , m_begin(TraceRecorder::enabled() ? latencyNow() : 0) {
+    }
+
+    ~TraceSpan() {
+        if (m_begin != 0) {
+            TraceRecorder::instance().record(m_name, m_begin, latencyNow(), m_arg);
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *m_name;
+    qint64 m_arg;
+    qint64 m_begin;
+};
+
+#define TRACKPLOT_TRACE_CONCAT_(a, b) a##b
+#define TRACKPLOT_TRACE_CONCAT(a, b) TRACKPLOT_TRACE_CONCAT_(a, b)
+// TRACKPLOT_TRACE_SPAN("name") or TRACKPLOT_TRACE_SPAN("name", slot)
+#define TRACKPLOT_TRACE_SPAN(...) const TraceSpan TRACKPLOT_TRACE_CONCAT(traceSpan_, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,260 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Header-only tracking kernels. Interpolation and hit-test are compile-time
+// policies plugged into one shared segment search, so every series type
+// gets the same inlined fast path (no virtual dispatch per frame).
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <QPointF>
+
+// Distance calculation from a point to a line segment
+inline qreal segmentDistance(const QPointF &point, const QPointF &lineStart, const QPointF &lineEnd) {
+    // Cache coordinate differences
+    const qreal dx = lineEnd.x() - lineStart.x();
+    const qreal dy = lineEnd.y() - lineStart.y();
+
+    // Calculate projection parameter (degenerate segment: point-to-point distance)
+    const qreal px = point.x() - lineStart.x();
+    const qreal py = point.y() - lineStart.y();
+    const qreal lengthSquared = dx * dx + dy * dy;
+    if (lengthSquared < std::numeric_limits<qreal>::epsilon()) {
+        return std::sqrt(px * px + py * py);
+    }
+    const qreal t = std::clamp((px * dx + py * dy) / lengthSquared, 0.0, 1.0);
+
+    // Distance to the closest point on the segment
+    const qreal distX = px - t * dx;
+    const qreal distY = py - t * dy;
+    return std::sqrt(distX * distX + distY * distY);
+}
+
+// --- Interpolation policies ---------------------------------------------------
+// at():       value of the series at x inside segment [idx, idx + 1]
+// distance(): hit-test distance from the cursor to that segment's shape
+
+struct LinearInterpolation {
+    static QPointF at(const QPointF *points, qsizetype /*count*/, const qsizetype idx, const qreal x) {
+        const QPointF &p1 = points[idx];
+        const QPointF &p2 = points[idx + 1];
+        const qreal t = (x - p1.x()) / (p2.x() - p1.x());
+        return {x, p1.y() + t * (p2.y() - p1.y())};
+    }
+
+    static qreal distance(const QPointF &cursor, const QPointF &p1, const QPointF &p2, const QPointF & /*pos*/) {
+        return segmentDistance(cursor, p1, p2);
+    }
+};
+
+struct CatmullRomInterpolation {
+    static constexpr qreal T = 1; // Catmull-Rom tension parameter
+
+    static QPointF interpolate(const qreal t,
+                               const QPointF &p0,
+                               const QPointF &p1,
+                               const QPointF &p2,
+                               const QPointF &p3) {
+        const qreal t2 = t * t;
+        const qreal t3 = t2 * t;
+
+        const qreal h1 = -T * t3 + 2 * T * t2 - T * t;
+        const qreal h2 = (2 - T) * t3 + (T - 3) * t2 + 1;
+        const qreal h3 = (T - 2) * t3 + (3 - 2 * T) * t2 + T * t;
+        const qreal h4 = T * t3 - T * t2;
+
+        return {
+            h1 * p0.x() + h2 * p1.x() + h3 * p2.x() + h4 * p3.x(),
+            h1 * p0.y() + h2 * p1.y() + h3 * p2.y() + h4 * p3.y()
+        };
+    }
+
+    static QPointF at(const QPointF *points, const qsizetype count, const qsizetype idx, const qreal x) {
+        // Fall back to linear interpolation for edge segments
+        if (idx == 0 || idx >= count - 2) {
+            return LinearInterpolation::at(points, count, idx, x);
+        }
+        const qreal t = (x - points[idx].x()) / (points[idx + 1].x() - points[idx].x());
+        return interpolate(t, points[idx - 1], points[idx], points[idx + 1], points[idx + 2]);
+    }
+
+    static qreal distance(const QPointF &cursor, const QPointF &p1, const QPointF & /*p2*/, const QPointF &pos) {
+        return segmentDistance(cursor, p1, pos);
+    }
+};
+
+// Step (digital) signals. Step-after is the classic sample-and-hold: each
+// sample holds until the next one; step-before jumps at the start of the
+// interval; step-center switches halfway between samples.
+enum class StepMode { Before, After, Center };
+
+template<StepMode Mode>
+struct StepInterpolation {
+    static QPointF at(const QPointF *points, qsizetype /*count*/, const qsizetype idx, const qreal x) {
+        const QPointF &p1 = points[idx];
+        const QPointF &p2 = points[idx + 1];
+        if constexpr (Mode == StepMode::After) {
+            return {x, x < p2.x() ? p1.y() : p2.y()};
+        } else if constexpr (Mode == StepMode::Before) {
+            return {x, x > p1.x() ? p2.y() : p1.y()};
+        } else {
+            const qreal mid = (p1.x() + p2.x()) / 2;
+            return {x, x < mid ? p1.y() : p2.y()};
+        }
+    }
+
+    // Distance to the held (horizontal) level under the cursor
+    static qreal distance(const QPointF &cursor, const QPointF &p1, const QPointF &p2, const QPointF &pos) {
+        return segmentDistance(cursor, {p1.x(), pos.y()}, {p2.x(), pos.y()});
+    }
+};
+
+using StepBeforeInterpolation = StepInterpolation<StepMode::Before>;
+using StepAfterInterpolation = StepInterpolation<StepMode::After>;
+using SampleHoldInterpolation = StepAfterInterpolation;
+using StepCenterInterpolation = StepInterpolation<StepMode::Center>;
+
+// --- Shared search -----------------------------------------------------------
+
+// First index whose x is not before mouseX, along the series' x order.
+// Direction is a template parameter, so the loops carry no ascending branch.
+template<bool Ascending>
+bool beforeX(const qreal x, const qreal mouseX) {
+    if constexpr (Ascending) {
+        return x < mouseX;
+    } else {
+        return x > mouseX;
+    }
+}
+
+template<bool Ascending>
+qsizetype lowerBoundX(const QPointF *points, qsizetype left, qsizetype right, const qreal mouseX) {
+    // Plain binary search on [left, right]
+    while (left < right) {
+        const qsizetype mid = left + (right - left) / 2;
+        if (beforeX<Ascending>(points[mid].x(), mouseX)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Galloping (exponential) search from the previous result: cursor moves are
+// spatially coherent, so the answer is usually a few steps away from hint.
+template<bool Ascending>
+qsizetype gallopX(const QPointF *points, const qsizetype count, const qreal mouseX, qsizetype hint) {
+    const qsizetype last = count - 1;
+    hint = std::clamp<qsizetype>(hint, 0, last);
+
+    qsizetype left;
+    qsizetype right;
+    if (beforeX<Ascending>(points[hint].x(), mouseX)) {
+        // Answer is after hint: step right 1, 2, 4, ... until overshooting
+        left = hint + 1;
+        qsizetype step = 1;
+        right = left;
+        while (right < last && beforeX<Ascending>(points[right].x(), mouseX)) {
+            left = right + 1;
+            right = std::min(last, right + step);
+            step *= 2;
+        }
+    } else {
+        // Answer is at or before hint: step left until undershooting
+        right = hint;
+        qsizetype step = 1;
+        left = hint;
+        while (left > 0 && !beforeX<Ascending>(points[left - 1].x(), mouseX)) {
+            right = left - 1;
+            left = std::max<qsizetype>(0, left - step);
+            step *= 2;
+        }
+    }
+    return lowerBoundX<Ascending>(points, std::min(left, last), std::min(right, last), mouseX);
+}
+
+inline qsizetype lowerBoundX(const QPointF *points, const qsizetype count, const qreal mouseX) {
+    if (points[0].x() < points[count - 1].x()) {
+        return lowerBoundX<true>(points, 0, count - 1, mouseX);
+    }
+    return lowerBoundX<false>(points, 0, count - 1, mouseX);
+}
+
+inline qsizetype lowerBoundX(const QPointF *points, const qsizetype count, const qreal mouseX,
+                             const qsizetype hint) {
+    if (points[0].x() < points[count - 1].x()) {
+        return gallopX<true>(points, count, mouseX, hint);
+    }
+    return gallopX<false>(points, count, mouseX, hint);
+}
+
+struct SegmentHit {
+    QPointF pos;
+    qreal distance{};
+    qsizetype index = -1;
+    bool isValid = false;
+};
+
+// Finds the segment under mouseX and evaluates it with the given policy.
+// The distance is only computed when requested (focus/hover mode).
+// hint: segment index found last time by the same caller (-1: none); updated
+// in place, so each caller (thread) must own its hint.
+template<typename Interpolation>
+SegmentHit trackSegment(const QPointF *points, const qsizetype count, const QPointF &chartPos,
+                        const bool withDistance, qsizetype &hint) {
+    // Check if there are enough points
+    if (count < 2) {
+        return {};
+    }
+
+    const qreal mouseX = chartPos.x();
+    const qsizetype bound = hint < 0
+                                ? lowerBoundX(points, count, mouseX)
+                                : lowerBoundX(points, count, mouseX, hint + 1);
+    // Check having a valid segment
+    const qsizetype idx = std::max<qsizetype>(0, bound - 1);
+    hint = idx;
+    if (idx + 1 >= count) {
+        return {};
+    }
+
+    // Get segment points and quick bounds check
+    const QPointF &p1 = points[idx];
+    const QPointF &p2 = points[idx + 1];
+    if (mouseX < std::min(p1.x(), p2.x()) || mouseX > std::max(p1.x(), p2.x())) {
+        return {};
+    }
+    // Check division by zero
+    if (std::abs(p2.x() - p1.x()) <= std::numeric_limits<qreal>::epsilon()) {
+        return {};
+    }
+
+    SegmentHit hit;
+    hit.index = idx;
+    hit.pos = Interpolation::at(points, count, idx, mouseX);
+    hit.isValid = true;
+    if (withDistance) {
+        hit.distance = Interpolation::distance(chartPos, p1, p2, hit.pos);
+    }
+    return hit;
+}
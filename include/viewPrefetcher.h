@@ -0,0 +1,165 @@
+#pragma once
+
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QCache>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include "compactSamples.h"
+#include "decimation.h"
+
+class DatasetIndex;
+class QXYSeries;
+
+// Decimated display for large series. The full data stays with the series'
+// tracker; what is drawn is assembled per view from cached min/max tiles.
+// After every view change the next views are predicted from the pan
+// velocity and zoom direction, and their missing tiles are computed off the
+// GUI thread, within a memory budget shared with the displayed tiles.
+class ViewPrefetcher final : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ViewPrefetcher(QObject *parent = nullptr);
+
+    ~ViewPrefetcher() override;
+
+    // Full data of a series (ascending x); its display is replaced by the
+    // decimated view from now on.
+    // With an index (see DatasetIndex), its sortedness flag and pyramid are
+    // used instead of looking at the points.
+    void setSource(int slot, QXYSeries *series, const QList<QPointF> &points,
+                   const DatasetIndex *index = nullptr);
+
+    // Same, for compact samples: tiles are decimated from the compact form.
+    void setSource(int slot, QXYSeries *series, const CompactSamples &samples);
+
+    // The series draws something else from now on.
+    void removeSource(int slot);
+
+    // Visible x range and plot width changed: redraw the sources, then prefetch.
+    void viewChanged(qreal xMin, qreal xMax, qreal plotWidth);
+
+    // Draw (and prefetch) this many levels coarser than the plot width calls
+    // for; the quality governor raises it while frames run over budget.
+    void setCoarseLevels(int levels);
+
+    [[nodiscard]] int coarseLevels() const { return m_coarseLevels; }
+
+    void setMemoryBudget(qsizetype bytes);
+
+    [[nodiscard]] qsizetype memoryBudget() const;
+
+    // Tile lookups of the displayed views: found in the cache vs. computed on
+    // the GUI thread.
+    [[nodiscard]] quint64 hits() const { return m_hits; }
+
+    [[nodiscard]] quint64 misses() const { return m_misses; }
+
+    void resetCounters();
+
+    // Statistics of the samples in the tiles currently displayed. With a
+    // DatasetIndex, count and sum (so the mean) cover exactly the visible
+    // samples, from the index's prefix sums.
+    [[nodiscard]] VisibleStats visibleStats(int slot) const;
+
+private:
+    struct Source {
+        QXYSeries *series = nullptr;
+        QList<QPointF> points; // Immutable once set (implicitly shared with the worker)
+        CompactSamples samples; // Compact sources instead of points
+        bool compact = false;
+        const DatasetIndex *index = nullptr; // Precomputed overview and sortedness, if any
+        DecimationGrid grid;
+        quint32 generation = 0;
+        VisibleStats stats;
+
+        [[nodiscard]] qsizetype size() const { return compact ? samples.size() : points.size(); }
+
+        [[nodiscard]] QPointF at(const qsizetype i) const { return compact ? samples.at(i) : points[i]; }
+
+        [[nodiscard]] QList<QPointF> mid(qsizetype from, qsizetype n) const;
+
+        [[nodiscard]] qsizetype lowerBound(qreal x) const;
+    };
+
+    struct TileKey {
+        int slot = -1;
+        quint32 generation = 0;
+        int level = 0;
+        qint64 index = 0;
+
+        bool operator==(const TileKey &) const = default;
+    };
+
+    friend size_t qHash(const TileKey &key, size_t seed) {
+        return qHashMulti(seed, key.slot, key.generation, key.level, key.index);
+    }
+
+    struct TileJob {
+        TileKey key;
+        QList<QPointF> points;
+        CompactSamples samples;
+        bool compact = false;
+        DecimationGrid grid;
+        DecimationTile result;
+    };
+
+    QList<Source> m_sources; // Indexed by tracker slot (series == nullptr: not decimated)
+    QCache<TileKey, DecimationTile> m_tiles{32 * 1024}; // Cost in KiB
+    quint32 m_nextGeneration = 0;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+
+    // Last two views, for the motion prediction
+    qreal m_xMin{};
+    qreal m_xMax{};
+    qreal m_plotWidth{};
+    qreal m_velocity{}; // Center shift per view change
+    qreal m_zoomRatio = 1; // Span ratio per view change
+    bool m_hasView = false;
+    int m_coarseLevels = 0;
+
+    // One prefetch batch in flight; the latest prediction waits (latest wins).
+    QFutureWatcher<void> *m_watcher{};
+    QList<TileJob> m_jobs;
+    QList<TileJob> m_pendingJobs;
+    bool m_hasPendingJobs = false;
+
+    void attach(int slot, Source &source);
+
+    [[nodiscard]] int levelFor(const Source &source, qreal columnWidth) const;
+
+    void display(int slot, Source &source);
+
+    const DecimationTile *tile(int slot, const Source &source, int level, qint64 index);
+
+    void predict();
+
+    void queueTiles(int slot, const Source &source, int level, qreal from, qreal to, QList<TileJob> &jobs) const;
+
+    void dispatch(QList<TileJob> jobs);
+
+    void onPrefetchFinished();
+
+    void insertTile(const TileKey &key, DecimationTile tile);
+};
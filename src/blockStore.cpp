@@ -0,0 +1,412 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "blockStore.h"
+#include <QMutexLocker>
+#include <bit>
+
+namespace {
+    constexpr quint64 mask(const int bits) {
+        return bits >= 64 ? ~quint64{0} : (quint64{1} << bits) - 1;
+    }
+
+    quint64 zigzag(const qint64 v) {
+        return (static_cast<quint64>(v) << 1) ^ static_cast<quint64>(v >> 63);
+    }
+
+    qint64 unzigzag(const quint64 z) {
+        return static_cast<qint64>((z >> 1) ^ (~(z & 1) + 1));
+    }
+
+    // MSB-first bit stream in 64-bit big-endian words
+    class BitWriter {
+    public:
+        void write(const quint64 value, int bits) {
+            while (bits > 0) {
+                const int take = std::min(bits, 64 - m_used);
+                const quint64 chunk = (value >> (bits - take)) & mask(take);
+                m_word = take == 64 ? chunk : (m_word << take) | chunk;
+                m_used += take;
+                bits -= take;
+                if (m_used == 64) {
+                    flushWord();
+                }
+            }
+        }
+
+        QByteArray finish() {
+            if (m_used > 0) {
+                m_word <<= 64 - m_used;
+                flushWord();
+            }
+            return m_out;
+        }
+
+    private:
+        QByteArray m_out;
+        quint64 m_word = 0;
+        int m_used = 0;
+
+        void flushWord() {
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                m_out.append(static_cast<char>((m_word >> shift) & 0xff));
+            }
+            m_word = 0;
+            m_used = 0;
+        }
+    };
+
+    class BitReader {
+    public:
+        explicit BitReader(const QByteArray &data)
+            : m_next(reinterpret_cast<const uchar *>(data.constData())) {
+        }
+
+        quint64 read(int bits) {
+            quint64 result = 0;
+            while (bits > 0) {
+                if (m_offset == 64) {
+                    load(); // Streams end on a whole word: never reads past the end
+                }
+                const int take = std::min(bits, 64 - m_offset);
+                const quint64 chunk = (m_word << m_offset) >> (64 - take);
+                result = take == 64 ? chunk : (result << take) | chunk;
+                m_offset += take;
+                bits -= take;
+            }
+            return result;
+        }
+
+        bool bit() { return read(1) != 0; }
+
+    private:
+        const uchar *m_next;
+        quint64 m_word = 0;
+        int m_offset = 64;
+
+        void load() {
+            m_word = 0;
+            for (int i = 0; i < 8; ++i) {
+                m_word = (m_word << 8) | m_next[i];
+            }
+            m_next += 8;
+            m_offset = 0;
+        }
+    };
+
+    // x: delta-of-delta of the bit pattern, zigzagged, in Gorilla buckets
+    void writeDelta(BitWriter &out, const qint64 deltaOfDelta) {
+        const quint64 z = zigzag(deltaOfDelta);
+        if (z == 0) {
+            out.write(0b0, 1);
+        } else if (z < (1 << 7)) {
+            out.write(0b10, 2);
+            out.write(z, 7);
+        } else if (z < (1 << 9)) {
+            out.write(0b110, 3);
+            out.write(z, 9);
+        } else if (z < (1 << 12)) {
+            out.write(0b1110, 4);
+            out.write(z, 12);
+        } else {
+            out.write(0b1111, 4);
+            out.write(z, 64);
+        }
+    }
+
+    qint64 readDelta(BitReader &in) {
+        if (!in.bit())
+            return 0;
+        if (!in.bit())
+            return unzigzag(in.read(7));
+        if (!in.bit())
+            return unzigzag(in.read(9));
+        if (!in.bit())
+            return unzigzag(in.read(12));
+        return unzigzag(in.read(64));
+    }
+
+    // y: XOR with the previous value; the meaningful bits reuse the previous
+    // leading/trailing-zero window when they fit in it
+    struct XorState {
+        quint64 previous = 0;
+        int leading = -1;
+        int trailing = 0;
+    };
+
+    void writeXor(BitWriter &out, XorState &state, const quint64 value) {
+        const quint64 x = value ^ state.previous;
+        state.previous = value;
+        if (x == 0) {
+            out.write(0b0, 1);
+            return;
+        }
+        const int leading = std::min(std::countl_zero(x), 31);
+        const int trailing = std::countr_zero(x);
+        if (state.leading >= 0 && leading >= state.leading && trailing >= state.trailing) {
+            out.write(0b10, 2);
+            out.write(x >> state.trailing, 64 - state.leading - state.trailing);
+            return;
+        }
+        const int significant = 64 - leading - trailing;
+        out.write(0b11, 2);
+        out.write(leading, 5);
+        out.write(significant - 1, 6);
+        out.write(x >> trailing, significant);
+        state.leading = leading;
+        state.trailing = trailing;
+    }
+
+    quint64 readXor(BitReader &in, XorState &state) {
+        if (in.bit()) {
+            if (in.bit()) {
+                state.leading = static_cast<int>(in.read(5));
+                const int significant = static_cast<int>(in.read(6)) + 1;
+                state.trailing = 64 - state.leading - significant;
+            }
+            const int significant = 64 - state.leading - state.trailing;
+            state.previous ^= in.read(significant) << state.trailing;
+        }
+        return state.previous;
+    }
+
+    QByteArray compress(const QList<QPointF> &points) {
+        BitWriter out;
+        quint64 previousX = 0;
+        qint64 previousDelta = 0;
+        XorState y;
+        for (qsizetype i = 0; i < points.size(); ++i) {
+            const auto x = std::bit_cast<quint64>(points[i].x());
+            if (i == 0) {
+                out.write(x, 64);
+            } else {
+                const auto delta = static_cast<qint64>(x - previousX); // Wraps, undone on decode
+                writeDelta(out, delta - previousDelta);
+                previousDelta = delta;
+            }
+            previousX = x;
+            writeXor(out, y, std::bit_cast<quint64>(points[i].y()));
+        }
+        return out.finish();
+    }
+
+    QList<QPointF> decompress(const QByteArray &data, const qsizetype count) {
+        QList<QPointF> points(count);
+        BitReader in(data);
+        quint64 x = 0;
+        qint64 delta = 0;
+        XorState y;
+        for (qsizetype i = 0; i < count; ++i) {
+            if (i == 0) {
+                x = in.read(64);
+            } else {
+                delta += readDelta(in);
+                x += static_cast<quint64>(delta);
+            }
+            points[i] = {std::bit_cast<qreal>(x), std::bit_cast<qreal>(readXor(in, y))};
+        }
+        return points;
+    }
+
+    void extend(BlockStore::BlockSummary &summary, const QPointF &p) {
+        if (summary.count == 0) {
+            summary.xFirst = p.x();
+            summary.minPoint = summary.maxPoint = p;
+        }
+        summary.xLast = p.x();
+        if (p.y() < summary.minPoint.y())
+            summary.minPoint = p;
+        if (p.y() > summary.maxPoint.y())
+            summary.maxPoint = p;
+        ++summary.count;
+    }
+
+    // Min and max of each column, in x order
+    void appendColumns(QList<QPointF> &out, const QList<QPointF> &points, const qreal xMin, const qreal width) {
+        qint64 column = std::numeric_limits<qint64>::min();
+        qsizetype minIndex = -1;
+        qsizetype maxIndex = -1;
+        auto flush = [&]() {
+            if (minIndex < 0)
+                return;
+            out.append(points[std::min(minIndex, maxIndex)]);
+            if (minIndex != maxIndex) {
+                out.append(points[std::max(minIndex, maxIndex)]);
+            }
+        };
+        for (qsizetype i = 0; i < points.size(); ++i) {
+            const auto c = static_cast<qint64>(std::floor((points[i].x() - xMin) / width));
+            if (c != column) {
+                flush();
+                column = c;
+                minIndex = maxIndex = i;
+            } else {
+                if (points[i].y() < points[minIndex].y()) minIndex = i;
+                if (points[i].y() > points[maxIndex].y()) maxIndex = i;
+            }
+        }
+        flush();
+    }
+}
+
+BlockStore::BlockStore(const qsizetype cacheBytes) {
+    setCacheLimit(cacheBytes);
+}
+
+void BlockStore::append(const QList<QPointF> &points) {
+    for (const QPointF &p: points) {
+        if (m_open.isEmpty()) {
+            m_summaries.append({m_size, 0, {}, {}, {}, {}});
+            m_open.reserve(blockSamples);
+        }
+        m_open.append(p);
+        extend(m_summaries.last(), p);
+        ++m_size;
+        if (m_open.size() == blockSamples) {
+            closeBlock();
+        }
+    }
+}
+
+std::shared_ptr<const BlockStore> BlockStore::snapshot() const {
+    auto copy = std::make_shared<BlockStore>(cacheLimit());
+    copy->m_summaries = m_summaries;
+    copy->m_blocks = m_blocks;
+    copy->m_open = m_open;
+    copy->m_size = m_size;
+    return copy;
+}
+
+void BlockStore::closeBlock() {
+    m_blocks.append(compress(m_open));
+    m_open.clear();
+}
+
+QRectF BlockStore::bounds() const {
+    if (m_summaries.isEmpty()) {
+        return {};
+    }
+    qreal yMin = m_summaries.first().minPoint.y();
+    qreal yMax = m_summaries.first().maxPoint.y();
+    for (const BlockSummary &s: m_summaries) {
+        yMin = std::min(yMin, s.minPoint.y());
+        yMax = std::max(yMax, s.maxPoint.y());
+    }
+    return {QPointF(m_summaries.first().xFirst, yMin), QPointF(m_summaries.last().xLast, yMax)};
+}
+
+qsizetype BlockStore::storedBytes() const {
+    qsizetype bytes = m_open.size() * static_cast<qsizetype>(sizeof(QPointF)) +
+                      m_summaries.size() * static_cast<qsizetype>(sizeof(BlockSummary));
+    for (const QByteArray &block: m_blocks) {
+        bytes += block.size();
+    }
+    return bytes;
+}
+
+void BlockStore::setCacheLimit(const qsizetype bytes) {
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(std::max<qsizetype>(0, bytes / 1024));
+}
+
+qsizetype BlockStore::cacheLimit() const {
+    QMutexLocker locker(&m_mutex);
+    return m_cache.maxCost() * 1024;
+}
+
+QList<QPointF> BlockStore::block(const qsizetype index) const {
+    if (index == m_blocks.size()) {
+        return m_open;
+    }
+    QMutexLocker locker(&m_mutex);
+    if (const QList<QPointF> *cached = m_cache.object(index)) {
+        return *cached; // Implicitly shared copy: stays valid after eviction
+    }
+    const QList<QPointF> decoded = decompress(m_blocks[index], blockSamples);
+    const qsizetype cost = std::max<qsizetype>(1, blockSamples * static_cast<qsizetype>(sizeof(QPointF)) / 1024);
+    m_cache.insert(index, new QList<QPointF>(decoded), cost);
+    return decoded;
+}
+
+qsizetype BlockStore::blockAt(const qreal value) const {
+    const auto it = std::upper_bound(m_summaries.cbegin(), m_summaries.cend(), value,
+                                     [](const qreal x, const BlockSummary &s) { return x < s.xFirst; });
+    return std::max<qsizetype>(0, it - m_summaries.cbegin() - 1);
+}
+
+QPointF BlockStore::at(const qsizetype i) const {
+    return block(i / blockSamples)[i % blockSamples];
+}
+
+qsizetype BlockStore::lowerBound(const qreal value) const {
+    if (m_size == 0) {
+        return 0;
+    }
+    // The answer is in the block holding value, or first in the next one
+    qsizetype b = blockAt(value);
+    if (m_summaries[b].xLast < value) {
+        if (b + 1 == m_summaries.size()) {
+            return m_size - 1;
+        }
+        return m_summaries[b + 1].first;
+    }
+    const QList<QPointF> points = block(b);
+    return m_summaries[b].first + lowerBoundX<true>(points.constData(), 0, points.size() - 1, value);
+}
+
+QList<QPointF> BlockStore::mid(const qsizetype from, const qsizetype n) const {
+    QList<QPointF> points;
+    points.reserve(n);
+    qsizetype i = from;
+    while (i < from + n) {
+        const QList<QPointF> decoded = block(i / blockSamples);
+        const qsizetype offset = i % blockSamples;
+        const qsizetype take = std::min(from + n - i, decoded.size() - offset);
+        points.append(decoded.mid(offset, take));
+        i += take;
+    }
+    return points;
+}
+
+QList<QPointF> BlockStore::view(const qreal xMin, const qreal xMax, const int columns) const {
+    QList<QPointF> view;
+    if (m_size == 0 || xMax <= xMin || columns <= 0) {
+        return view;
+    }
+    const qreal width = (xMax - xMin) / columns;
+    const qsizetype firstBlock = std::max<qsizetype>(0, blockAt(xMin) - 1);
+    const qsizetype lastBlock = std::min(m_summaries.size() - 1, blockAt(xMax) + 1);
+    for (qsizetype b = firstBlock; b <= lastBlock; ++b) {
+        const BlockSummary &s = m_summaries[b];
+        if (s.xLast - s.xFirst <= width) {
+            // Narrower than a column: its extremes, from the summary alone
+            const bool minFirst = s.minPoint.x() <= s.maxPoint.x();
+            view.append(minFirst ? s.minPoint : s.maxPoint);
+            if (s.minPoint != s.maxPoint) {
+                view.append(minFirst ? s.maxPoint : s.minPoint);
+            }
+        } else if (static_cast<qreal>(s.count) <= 4 * (s.xLast - s.xFirst) / width) {
+            view.append(block(b)); // Sparse enough to draw as is
+        } else {
+            appendColumns(view, block(b), xMin, width);
+        }
+    }
+    return view;
+}
@@ -0,0 +1,111 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "chartLinkGroup.h"
+#include "frameScheduler.h"
+#include "traceRecorder.h"
+
+ChartLinkGroup::ChartLinkGroup(QObject *parent)
+    : QObject(parent) {
+}
+
+ChartLinkGroup::~ChartLinkGroup() {
+    for (const auto view: m_views) {
+        view->m_linkGroup = nullptr;
+    }
+}
+
+void ChartLinkGroup::addView(ZoomAndScroll *view) {
+    if (!view || view->m_linkGroup == this)
+        return;
+    if (view->m_linkGroup) {
+        view->m_linkGroup->removeView(view);
+    }
+    m_views.append(view);
+    view->m_linkGroup = this;
+    if (m_hasRange) {
+        view->applyLinkedXRange(m_rangeMin, m_rangeMax);
+    }
+}
+
+void ChartLinkGroup::removeView(ZoomAndScroll *view) {
+    if (!view || view->m_linkGroup != this)
+        return;
+    m_views.removeOne(view);
+    view->m_linkGroup = nullptr;
+    if (m_rangeSource == view) {
+        m_rangeSource = nullptr;
+    }
+}
+
+void ChartLinkGroup::requestXRange(ZoomAndScroll *source, const qreal min, const qreal max) {
+    // Press/release also refresh the range: only real changes are propagated
+    if (m_hasRange && qFuzzyCompare(min, m_rangeMin) && qFuzzyCompare(max, m_rangeMax))
+        return;
+    m_rangeSource = source;
+    m_rangeMin = min;
+    m_rangeMax = max;
+    m_hasRange = true;
+
+    // Committed on the scheduler's next frame (right away when it is idle);
+    // changes arriving before it are merged into one (latest range wins).
+    FrameScheduler::instance()->post(this, [this]() { commitXRange(); });
+}
+
+void ChartLinkGroup::commitXRange() {
+    for (const auto view: m_views) {
+        if (view != m_rangeSource) {
+            view->applyLinkedXRange(m_rangeMin, m_rangeMax);
+        }
+    }
+    emit xRangeChanged(m_rangeMin, m_rangeMax);
+}
+
+void ChartLinkGroup::track(const ZoomAndScroll *source, const QPointF &chartPos, const QPointF &mousePos) {
+    TRACKPLOT_TRACE_SPAN("linkTrack");
+    // Every member tracks the same x; the other views get the cursor mapped
+    // into their own plot (only its x matters for line-intersection tracking),
+    // in scene coordinates like the source's. Members with line tracking off
+    // (or in focus mode) are left alone, as their own moves would.
+    // Staged like a single view's request (latest wins), so the scheduler's
+    // one batch in flight, priorities and hidden-view skipping apply to all.
+    for (const auto view: m_views) {
+        const ViewLimits limits = view->viewLimits();
+        if (view == source) {
+            view->m_pendingBatch = {chartPos, mousePos, limits, false};
+        } else if (view->toggleState && !view->toggleFocus) {
+            const QPointF memberPos(chartPos.x(), (limits.yMin + limits.yMax) / 2);
+            const QPointF memberScenePos = view->chart()->mapToScene(view->chart()->mapToPosition(memberPos));
+            view->m_pendingBatch = {memberPos, memberScenePos, limits, false};
+        } else {
+            continue;
+        }
+        view->m_hasPendingBatch = !view->m_trackers.isEmpty();
+    }
+}
+
+void ChartLinkGroup::hideTracking(const ZoomAndScroll *source) const {
+    // The cursor left the source view (or tracking stopped): clear the rest
+    for (const auto view: m_views) {
+        if (view != source) {
+            view->hideTrackers();
+        }
+    }
+}
@@ -0,0 +1,166 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "compactSamples.h"
+#include <limits>
+
+namespace {
+    constexpr qreal int16Levels = 65534; // Symmetric: rounds to [-32767, 32767]
+
+    // Midrange of the y values, so float32 offsets keep the most precision
+    std::pair<qreal, qreal> rangeOf(const QList<QPointF> &points) {
+        qreal yMin = std::numeric_limits<qreal>::max();
+        qreal yMax = std::numeric_limits<qreal>::lowest();
+        for (const QPointF &p: points) {
+            yMin = std::min(yMin, p.y());
+            yMax = std::max(yMax, p.y());
+        }
+        return {yMin, yMax};
+    }
+
+    // Whether x follows first + i * step, within float32 relative precision
+    bool isUniform(const QList<QPointF> &points, const qreal step) {
+        const qreal x0 = points.first().x();
+        const qreal tolerance = std::abs(step) * 1e-6;
+        for (qsizetype i = 1; i < points.size(); ++i) {
+            if (std::abs(points[i].x() - (x0 + static_cast<qreal>(i) * step)) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+CompactSamples CompactSamples::uniform(const qreal x0, const qreal step, const QList<float> &values) {
+    CompactSamples samples;
+    samples.m_x0 = x0;
+    samples.m_step = step;
+    samples.m_count = values.size();
+    if (values.isEmpty()) {
+        return samples;
+    }
+    const auto [low, high] = std::minmax_element(values.cbegin(), values.cend());
+    samples.m_yMin = *low;
+    samples.m_yMax = *high;
+    samples.m_yf = values; // Offset 0: float32 values are already what is stored
+    return samples;
+}
+
+CompactSamples CompactSamples::uniform(const qreal x0, const qreal step, const QList<qint16> &raw,
+                                       const qreal scale, const qreal offset) {
+    CompactSamples samples;
+    samples.m_yEncoding = YEncoding::Int16;
+    samples.m_x0 = x0;
+    samples.m_step = step;
+    samples.m_yScale = scale;
+    samples.m_yOffset = offset;
+    samples.m_count = raw.size();
+    samples.m_yi = raw; // Implicitly shared with the acquisition buffer
+    if (raw.isEmpty()) {
+        return samples;
+    }
+    const auto [low, high] = std::minmax_element(raw.cbegin(), raw.cend());
+    samples.m_yMin = std::min(offset + scale * *low, offset + scale * *high);
+    samples.m_yMax = std::max(offset + scale * *low, offset + scale * *high);
+    return samples;
+}
+
+CompactSamples CompactSamples::fromPoints(const QList<QPointF> &points, const YEncoding yEncoding) {
+    CompactSamples samples;
+    samples.m_yEncoding = yEncoding;
+    samples.m_count = points.size();
+    if (points.isEmpty()) {
+        return samples;
+    }
+
+    const qsizetype count = points.size();
+    samples.m_x0 = points.first().x();
+    samples.m_step = count > 1 ? (points.last().x() - samples.m_x0) / static_cast<qreal>(count - 1) : 1;
+    if (count < 2 || !isUniform(points, samples.m_step)) {
+        samples.m_xEncoding = XEncoding::Float32;
+        samples.m_xs.resize(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            samples.m_xs[i] = static_cast<float>(points[i].x() - samples.m_x0);
+        }
+    }
+
+    const auto [yMin, yMax] = rangeOf(points);
+    samples.m_yMin = yMin;
+    samples.m_yMax = yMax;
+    samples.m_yOffset = (yMin + yMax) / 2;
+    if (yEncoding == YEncoding::Float32) {
+        samples.m_yf.resize(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            samples.m_yf[i] = static_cast<float>(points[i].y() - samples.m_yOffset);
+        }
+    } else {
+        samples.m_yScale = yMax > yMin ? (yMax - yMin) / int16Levels : 1;
+        samples.m_yi.resize(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            samples.m_yi[i] = static_cast<qint16>(std::lround((points[i].y() - samples.m_yOffset) / samples.m_yScale));
+        }
+    }
+    return samples;
+}
+
+qreal CompactSamples::x(const qsizetype i) const {
+    return visit([i](const auto &access) { return access.x(i); });
+}
+
+qreal CompactSamples::y(const qsizetype i) const {
+    return visit([i](const auto &access) { return access.y(i); });
+}
+
+qsizetype CompactSamples::lowerBound(const qreal value) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    return visit([value](const auto &access) { return access.lowerBound(value); });
+}
+
+qsizetype CompactSamples::lowerBound(const qreal value, const qsizetype hint) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    return visit([value, hint](const auto &access) { return access.lowerBound(value, hint); });
+}
+
+QList<QPointF> CompactSamples::mid(const qsizetype from, const qsizetype n) const {
+    return visit([from, n](const auto &access) {
+        QList<QPointF> points(n);
+        for (qsizetype i = 0; i < n; ++i) {
+            points[i] = access.at(from + i);
+        }
+        return points;
+    });
+}
+
+QRectF CompactSamples::bounds() const {
+    if (m_count == 0) {
+        return {};
+    }
+    return {QPointF(x(0), m_yMin), QPointF(x(m_count - 1), m_yMax)};
+}
+
+qsizetype CompactSamples::bytes() const {
+    return m_xs.size() * static_cast<qsizetype>(sizeof(float)) +
+           m_yf.size() * static_cast<qsizetype>(sizeof(float)) +
+           m_yi.size() * static_cast<qsizetype>(sizeof(qint16));
+}
@@ -18,9 +18,69 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "customEvents.h"
+#include "chartLinkGroup.h"
+#include "datasetIndex.h"
+#include "frameScheduler.h"
+#include "viewPrefetcher.h"
+#include "segmentKernels.h"
+#include "traceRecorder.h"
 #include <QtCharts/QValueAxis>
+#include <QGraphicsPixmapItem>
 #include <QScopedPointer>
+#include <QScreen>
+#include <QtMath>
 #include <QtConcurrent/QtConcurrent>
+#include <charconv>
+#include <string_view>
+
+namespace {
+// Appends label text into a fixed char buffer; numbers go through
+// std::to_chars, so per-frame formatting never touches the heap.
+class LabelWriter {
+public:
+    explicit LabelWriter(const std::span<char> buffer)
+        : m_first(buffer.data()), m_out(buffer.data()), m_last(buffer.data() + buffer.size()) {
+    }
+
+    LabelWriter &text(const std::string_view s) {
+        const auto n = std::min<std::ptrdiff_t>(m_last - m_out, static_cast<std::ptrdiff_t>(s.size()));
+        m_out = std::copy_n(s.data(), n, m_out);
+        return *this;
+    }
+
+    // Two decimals, same as QString::arg(v, 0, 'f', 2); values too wide for
+    // the buffer fall back to the shortest general form.
+    LabelWriter &number(const qreal v) {
+        std::to_chars_result r = std::to_chars(m_out, m_last, v, std::chars_format::fixed, 2);
+        if (r.ec != std::errc()) {
+            r = std::to_chars(m_out, m_last, v, std::chars_format::general, 6);
+        }
+        if (r.ec == std::errc()) {
+            m_out = r.ptr;
+        }
+        return *this;
+    }
+
+    LabelWriter &integer(const qint64 v) {
+        if (const std::to_chars_result r = std::to_chars(m_out, m_last, v); r.ec == std::errc()) {
+            m_out = r.ptr;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] qsizetype length() const { return m_out - m_first; }
+
+private:
+    char *m_first;
+    char *m_out;
+    char *m_last;
+};
+
+bool sameLimits(const ViewLimits &a, const ViewLimits &b) {
+    return qFuzzyCompare(a.xMin, b.xMin) && qFuzzyCompare(a.xMax, b.xMax) &&
+           qFuzzyCompare(a.yMin, b.yMin) && qFuzzyCompare(a.yMax, b.yMax);
+}
+} // namespace
 
 ZoomAndScroll::ZoomAndScroll(QChart *chart, QWidget *parent)
     : QChartView(chart, parent)
@@ -31,64 +91,450 @@ ZoomAndScroll::ZoomAndScroll(QChart *chart, QWidget *parent)
       , toggleFocus(false)
       , toggleLines(false) {
     setMouseTracking(true); // Enable mouse tracking (runs once)
-    // Single watcher for the batched, all-series intersection task.
-    m_batchWatcher = new QFutureWatcher<QList<TrackResult> >(this);
-    connect(m_batchWatcher, &QFutureWatcher<QList<TrackResult> >::finished,
-            this, [this]() { onBatchFinished(); });
+    // Frames and tracking batches are driven by the shared scheduler.
+    FrameScheduler::instance()->registerView(this);
+    m_prefetcher = new ViewPrefetcher(this);
+    // One overlay-expiry timer for all the tracked series (see restartExpiry)
+    m_expiryClock.start();
+    m_expiryTimer = new QTimer(this);
+    m_expiryTimer->setSingleShot(true);
+    connect(m_expiryTimer, &QTimer::timeout, this, [this]() { onExpiryTimeout(); });
+    // Full quality comes back once the cursor has been resting for a moment.
+    m_idleTimer = new QTimer(this);
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(250);
+    connect(m_idleTimer, &QTimer::timeout, this, [this]() { setQuality(Quality::Full); });
+    m_reportTimer = new QTimer(this);
+    m_reportTimer->setInterval(1000);
+    connect(m_reportTimer, &QTimer::timeout, this, [this]() { emitLatencyReport(); });
+}
+
+ZoomAndScroll::~ZoomAndScroll() {
+    // The tracking worker reads this view's callbacks and buffers in place
+    if (m_linkGroup) {
+        m_linkGroup->removeView(this);
+    }
+    FrameScheduler::instance()->unregisterView(this);
+    // The series outlive this body (the scene deletes them later on)
+    for (const Tracker &tracker: std::as_const(m_trackers)) {
+        if (tracker.detach) {
+            tracker.detach();
+        }
+    }
 }
 
-void ZoomAndScroll::registerTracker(TrackPrepareFn prepare, TrackComputeFn compute,
-                                    TrackRenderFn render) {
-    m_prepareFns.append(std::move(prepare));
-    m_computeFns.append(std::move(compute));
-    m_renderFns.append(std::move(render));
+void ZoomAndScroll::setFrameBudget(const qreal msec) {
+    m_frameBudget = msec;
+    if (msec < 0) {
+        setQuality(Quality::Full); // Governor disabled
+    }
 }
 
-void ZoomAndScroll::runBatchTracking(const QPointF &chartPos, const QPointF &mousePos,
-                                     const QVector<qreal> &lims, const bool focusEnabled) {
-    if (m_computeFns.isEmpty())
+void ZoomAndScroll::setHoverRadius(const qreal pixels) {
+    m_hoverRadius = std::max<qreal>(0, pixels);
+    m_hasFocusPos = false; // Re-test on the next move
+}
+
+qreal ZoomAndScroll::frameBudget() const {
+    return qFuzzyIsNull(m_frameBudget) ? static_cast<qreal>(FrameScheduler::instance()->frameInterval()) : m_frameBudget;
+}
+
+void ZoomAndScroll::setQuality(const Quality quality) {
+    if (quality == m_quality)
+        return;
+    m_quality = quality;
+    m_overBudgetFrames = 0;
+    m_prefetcher->setCoarseLevels(quality >= Quality::CoarseDecimation ? 1 : 0);
+    emit qualityChanged(quality);
+}
+
+void ZoomAndScroll::evaluateFrameCost() {
+    const qreal budget = frameBudget();
+    if (budget < 0)
+        return;
+
+    if (static_cast<qreal>(m_frameCostNs) / 1e6 <= budget) {
+        m_overBudgetFrames = 0;
+        return;
+    }
+    // Step down only after a few consecutive slow frames, so a one-off hiccup
+    // (e.g. the first label creation) does not cost any quality.
+    constexpr int slowFramesToStepDown = 3;
+    if (++m_overBudgetFrames >= slowFramesToStepDown && m_quality != Quality::CoarseDecimation) {
+        setQuality(static_cast<Quality>(static_cast<int>(m_quality) + 1));
+    }
+}
+
+bool ZoomAndScroll::viewportEvent(QEvent *event) {
+    // Repaints only count towards the frame cost while the cursor is moving.
+    if (event->type() != QEvent::Paint || (!m_frameActive && !m_latencyEnabled && !TraceRecorder::enabled())) {
+        return QChartView::viewportEvent(event);
+    }
+    TRACKPLOT_TRACE_SPAN("paint");
+    QElapsedTimer paintClock;
+    paintClock.start();
+    const bool handled = QChartView::viewportEvent(event);
+    const qint64 paintNs = paintClock.nsecsElapsed();
+    if (m_frameActive) {
+        m_frameCostNs += paintNs;
+    }
+    // The HUD's own refresh would otherwise keep the reports (and itself) going
+    const bool hudOnly = std::exchange(m_hudRepaint, false) && !m_frameActive && m_paintInputNs == 0;
+    if (m_latencyEnabled && !hudOnly) {
+        recordLatency(LatencyStage::Paint, paintNs);
+        ++m_reportPaints;
+        if (m_paintInputNs != 0) {
+            recordLatency(LatencyStage::EndToEnd, latencyNow() - m_paintInputNs);
+            m_paintInputNs = 0;
+        }
+    }
+    return handled;
+}
+
+void ZoomAndScroll::setLatencyTracking(const bool enabled) {
+    if (enabled == m_latencyEnabled)
+        return;
+    m_latencyEnabled = enabled;
+    m_moveInputNs = m_batchInputNs = m_paintInputNs = 0;
+    m_reportPaints = 0;
+    if (enabled) {
+        m_reportClock.start();
+        m_reportTimer->start();
+    } else {
+        m_reportTimer->stop();
+        setLatencyHud(false);
+    }
+}
+
+void ZoomAndScroll::resetLatency() {
+    for (LatencyHistogram &histogram: m_latency) {
+        histogram.reset();
+    }
+}
+
+void ZoomAndScroll::setLatencyHud(const bool visible) {
+    if (visible == m_hudVisible)
         return;
+    m_hudVisible = visible;
+    if (visible) {
+        setLatencyTracking(true);
+    }
+    viewport()->update();
+}
+
+void ZoomAndScroll::emitLatencyReport() {
+    const qint64 elapsedMs = m_reportClock.restart();
+    const quint64 paints = std::exchange(m_reportPaints, 0);
+    if (paints == 0)
+        return; // Nothing happened on screen
+    LatencyReport report;
+    report.fps = elapsedMs > 0 ? static_cast<qreal>(paints) * 1000 / static_cast<qreal>(elapsedMs) : 0;
+    for (int i = 0; i < static_cast<int>(LatencyStage::Count); ++i) {
+        report.p50Ns[i] = m_latency[i].percentile(0.50);
+        report.p99Ns[i] = m_latency[i].percentile(0.99);
+    }
+    m_lastReport = report;
+    emit latencyReport(report);
+    if (m_hudVisible) {
+        m_hudRepaint = true;
+        viewport()->update();
+    }
+}
 
-    // Cancel the in-flight batch (if any) before dispatching a new one.
-    if (m_batchWatcher->isRunning()) {
-        m_batchWatcher->cancel();
+void ZoomAndScroll::drawHud(QPainter *painter) const {
+    const auto ms = [this](const LatencyStage stage) {
+        return static_cast<double>(m_lastReport.p99Ns[static_cast<int>(stage)]) / 1e6;
+    };
+    const QString text = QString::asprintf("%.0f fps   p99 %.1f ms\ncompute %.2f  render %.2f  paint %.2f ms",
+                                           m_lastReport.fps, ms(LatencyStage::EndToEnd),
+                                           ms(LatencyStage::Compute), ms(LatencyStage::Render),
+                                           ms(LatencyStage::Paint));
+    painter->save();
+    painter->resetTransform(); // Viewport coordinates
+    painter->setFont(QFont("Monospace", 9));
+    const QPoint origin = mapFromScene(chart()->plotArea().topLeft()) + QPoint(8, 8);
+    const QRect box = painter->fontMetrics().boundingRect(QRect(origin, QSize(600, 100)), Qt::AlignLeft, text)
+            .adjusted(-4, -2, 4, 2);
+    painter->fillRect(box, QColor(0, 0, 0, 150));
+    painter->setPen(Qt::white);
+    painter->drawText(box.adjusted(4, 2, -4, -2), Qt::AlignLeft, text);
+    painter->restore();
+}
+
+int ZoomAndScroll::registerTracker(QXYSeries *series, Tracker tracker) {
+    // No wait for the worker: it reads m_batchTrackers, which this detaches from
+    const qsizetype free = m_trackedSeries.indexOf(nullptr);
+    if (free >= 0) {
+        m_trackers[free] = std::move(tracker);
+        m_trackedSeries[free] = series;
+        m_expiry[free] = ExpiryNode{};
+        return static_cast<int>(free);
     }
+    m_trackers.append(std::move(tracker));
+    m_trackedSeries.append(series);
+    m_overlaysShown.append(false);
+    m_intersections.resize(m_trackers.size());
+    m_expiry.append(ExpiryNode{});
+    return static_cast<int>(m_trackers.size() - 1);
+}
 
+void ZoomAndScroll::unregisterTracker(const int slot) {
+    if (slot < 0 || slot >= m_trackers.size()) {
+        return;
+    }
+    if (m_batchRunning && slot < m_slotActive.size() && m_slotActive[slot]) {
+        // Its compute callback may be running and the series is going away:
+        // only then wait, and drop the result before the batch is rendered
+        FrameScheduler::instance()->waitForBatch();
+        m_batchResults[slot] = TrackResult{};
+    }
+    unlinkExpiry(slot);
+    m_trackers[slot] = Tracker{};
+    m_trackedSeries[slot] = nullptr; // Skipped by every per-slot loop
+    m_overlaysShown[slot] = false;
+    m_intersections[slot].valid = false;
+    if (m_bottomSlot == slot) {
+        m_bottomSlot = -1;
+    }
+    m_prefetcher->removeSource(slot);
+}
+
+void ZoomAndScroll::overlaysShown(const int slot) {
+    m_overlaysShown[slot] = true;
+    restartExpiry(slot); // Whatever is drawn (lines, bullet, labels) expires together
+}
+
+void ZoomAndScroll::overlaysHidden(const int slot) {
+    m_overlaysShown[slot] = false;
+    unlinkExpiry(slot); // Nothing left to expire
+    // Only this series' entry: other series keep their intersections
+    m_intersections[slot].valid = false;
+    if (m_bottomSlot == slot) {
+        m_bottomSlot = -1;
+    }
+}
+
+void ZoomAndScroll::setLabelTimeout(const int msec) {
+    m_labelTimeout = std::max(1, msec);
+}
+
+void ZoomAndScroll::restartExpiry(const int slot) {
+    // Same timeout for every slot, so the list stays sorted by deadline by
+    // moving the restarted slot to the tail: O(1), no timer call per frame.
+    unlinkExpiry(slot);
+    ExpiryNode &node = m_expiry[slot];
+    node.deadline = m_expiryClock.elapsed() + m_labelTimeout;
+    node.prev = m_expiryTail;
+    node.next = -1;
+    node.linked = true;
+    if (m_expiryTail >= 0) {
+        m_expiry[m_expiryTail].next = slot;
+    } else {
+        m_expiryHead = slot;
+    }
+    m_expiryTail = slot;
+
+    // Lazily armed: a running timer fires at the head's deadline or earlier,
+    // and re-arms itself for whatever is still pending then.
+    if (!m_expiryTimer->isActive()) {
+        m_expiryTimer->start(m_labelTimeout);
+    }
+}
+
+void ZoomAndScroll::unlinkExpiry(const int slot) {
+    ExpiryNode &node = m_expiry[slot];
+    if (!node.linked)
+        return;
+    if (node.prev >= 0) {
+        m_expiry[node.prev].next = node.next;
+    } else {
+        m_expiryHead = node.next;
+    }
+    if (node.next >= 0) {
+        m_expiry[node.next].prev = node.prev;
+    } else {
+        m_expiryTail = node.prev;
+    }
+    node.prev = node.next = -1;
+    node.linked = false;
+}
+
+void ZoomAndScroll::onExpiryTimeout() {
+    // Hide every series whose deadline has passed, oldest first; each one
+    // only hides its own overlays (and unlinks itself through overlaysHidden).
+    const qint64 now = m_expiryClock.elapsed();
+    while (m_expiryHead >= 0 && m_expiry[m_expiryHead].deadline <= now) {
+        const int slot = m_expiryHead;
+        unlinkExpiry(slot);
+        m_trackers.at(slot).hide();
+    }
+    if (m_expiryHead >= 0) {
+        m_expiryTimer->start(static_cast<int>(m_expiry[m_expiryHead].deadline - now));
+    }
+}
+
+void ZoomAndScroll::hideTrackers() {
+    // Series whose overlays are already hidden are skipped entirely
+    for (qsizetype i = 0; i < m_trackers.size(); ++i) {
+        if (m_overlaysShown[i]) {
+            m_trackers.at(i).hide();
+        }
+    }
+    m_hasFocusPos = false;
+    emit hideWhenMove(); // Kept for external listeners
+}
+
+void ZoomAndScroll::dispatchFocus(const QPointF &chartPos, const QPointF &mousePos,
+                                  const QPointF &globalPos) {
+    TRACKPLOT_TRACE_SPAN("focus");
+    // Same cursor value as the last focus frame: nothing changed for any series
+    if (m_hasFocusPos && chartPos == m_lastFocusPos)
+        return;
+    m_lastFocusPos = chartPos;
+    m_hasFocusPos = true;
+
+    // The Tooltip is displayed only if a series lies within the hover radius,
+    // measured in pixels (axes scale independently)
+    const QRectF plot = chart()->plotArea();
+    if (xMax - xMin <= std::numeric_limits<qreal>::epsilon() ||
+        yMax - yMin <= std::numeric_limits<qreal>::epsilon() || plot.isEmpty()) {
+        QToolTip::hideText();
+        return;
+    }
+    const HoverQuery query{
+        chartPos, mousePos,
+        plot.width() / (xMax - xMin), plot.height() / (yMax - yMin),
+        m_hoverRadius
+    };
+
+    // Hit-test the visible series and keep the nearest one, so one series can
+    // no longer hide the tooltip another one has just shown.
+    TrackResult best;
+    for (qsizetype i = 0; i < m_trackers.size(); ++i) {
+        if (!m_trackedSeries[i] || !m_trackedSeries[i]->isVisible())
+            continue;
+        const TrackResult hit = m_trackers.at(i).focus(query);
+        if (hit.isValid && hit.distance <= m_hoverRadius &&
+            (!best.isValid || hit.distance < best.distance)) {
+            best = hit;
+        }
+    }
+
+    if (best.isValid) {
+        std::array<char, 96> text{};
+        LabelWriter writer(text);
+        writer.text("X: ").number(best.pos.x()).text(", Y: ").number(best.pos.y());
+        if (best.binCount >= 0) {
+            writer.text(", N: ").integer(best.binCount);
+        }
+        const qsizetype length = writer.length();
+        QToolTip::showText(globalPos.toPoint(), QString::fromLatin1(text.data(), length));
+    } else {
+        QToolTip::hideText(); // Hides the previous tooltip immediately
+    }
+}
+
+void ZoomAndScroll::runBatchTracking(const QPointF &chartPos, const QPointF &mousePos,
+                                     const ViewLimits &lims, const bool focusEnabled) {
+    if (m_trackers.isEmpty())
+        return;
+
+    // Staged only: the scheduler runs every view's staged request in one
+    // background batch at the end of the frame. One batch is in flight at a
+    // time, so a newer request waits for it (latest wins) and the worker never
+    // races with the snapshots and buffers refreshed in prepareBatch().
+    m_pendingBatch = {chartPos, mousePos, lims, focusEnabled};
+    m_hasPendingBatch = true;
+}
+
+void ZoomAndScroll::prepareBatch() {
     // Refresh every series' snapshot on the GUI thread before dispatching.
     // Worker only ever reads already-detached, immutable point data.
-    for (const auto &prepare: m_prepareFns) {
-        prepare();
-    }
-
-    // Copy the compute callbacks.
-    // Worker only reads its series' immutable cached snapshot (allocation-free).
-    const QList<TrackComputeFn> computeFns = m_computeFns;
-    const auto future = QtConcurrent::run(
-        [computeFns, chartPos, mousePos, lims, focusEnabled]() {
-            QList<TrackResult> results;
-            results.reserve(computeFns.size());
-            for (const auto &compute: computeFns) {
-                results.append(compute(chartPos, mousePos, lims, focusEnabled));
-            }
-            return results;
-        });
-    m_batchWatcher->setFuture(future);
+    // Hidden series are neither refreshed nor computed.
+    // No batch is in flight here: the worker's registry and buffers catch up
+    // with the trackers registered since the last one (O(1) when unchanged).
+    m_batchTrackers = m_trackers;
+    const qsizetype n = m_batchTrackers.size();
+    m_slotActive.resize(n);
+    m_batchResults.resize(n);
+    m_batchRunning = true;
+    for (qsizetype i = 0; i < n; ++i) {
+        m_slotActive[i] = m_trackedSeries[i] && m_trackedSeries[i]->isVisible();
+        if (m_slotActive[i]) {
+            TRACKPLOT_TRACE_SPAN("prepare", i);
+            m_batchTrackers.at(i).prepare();
+        }
+    }
+    m_activeBatchInputNs = std::exchange(m_batchInputNs, 0);
+    m_batchTimed = m_latencyEnabled;
+    if (m_batchTimed) {
+        m_batchDispatchNs = latencyNow();
+    }
 }
 
-void ZoomAndScroll::onBatchFinished() {
-    if (m_batchWatcher->isCanceled())
-        return;
+void ZoomAndScroll::computeBatch(const BatchRequest &request) {
+    // Worker thread
+    TRACKPLOT_TRACE_SPAN("computeBatch");
+    const qint64 start = m_batchTimed ? latencyNow() : 0;
+    const qsizetype n = m_batchTrackers.size();
+    for (qsizetype i = 0; i < n; ++i) {
+        if (!m_slotActive[i]) {
+            m_batchResults[i] = TrackResult{};
+            continue;
+        }
+        TRACKPLOT_TRACE_SPAN("compute", i);
+        m_batchResults[i] = m_batchTrackers.at(i).compute(request.chartPos, request.mousePos,
+                                                        request.limits, request.focusEnabled);
+    }
+    if (m_batchTimed) {
+        recordLatency(LatencyStage::BatchQueue, start - m_batchDispatchNs);
+        recordLatency(LatencyStage::Compute, latencyNow() - start);
+    }
+}
 
-    const QList<TrackResult> results = m_batchWatcher->result();
-    // Render every series' result together so currentIntersections &
+void ZoomAndScroll::finishBatch() {
+    TRACKPLOT_TRACE_SPAN("finishBatch");
+    const qint64 start = m_latencyEnabled ? latencyNow() : 0;
+    m_batchRunning = false;
+    // Slots registered since the batch was prepared have no result yet
+    const qsizetype n = m_batchResults.size();
+    // Fill the intersection table and find the bottom-most series once per
+    // batch, before any series renders (O(n) per frame instead of O(n²)).
+    const ViewLimits limits = viewLimits();
+    m_bottomSlot = -1;
+    qreal lowestY = std::numeric_limits<qreal>::infinity();
+    for (qsizetype i = 0; i < n; ++i) {
+        const TrackResult &result = m_batchResults[i];
+        SlotIntersection &entry = m_intersections[i];
+        entry.valid = result.isValid && !result.pos.isNull() && limits.contains(result.pos);
+        entry.point = result.pos;
+        if (entry.valid && entry.point.y() < lowestY) {
+            lowestY = entry.point.y();
+            m_bottomSlot = static_cast<int>(i);
+        }
+    }
+
+    // Render every series' result together so the intersections &
     // crosshair/labels are updated as one atomic frame.
-    const int n = std::min<int>(static_cast<int>(results.size()), static_cast<int>(m_renderFns.size()));
-    for (int i = 0; i < n; ++i) {
-        m_renderFns[i](results[i]);
+    // Series without a hit and with nothing shown have nothing to update.
+    for (qsizetype i = 0; i < n; ++i) {
+        if (m_intersections[i].valid || m_overlaysShown[i]) {
+            TRACKPLOT_TRACE_SPAN("render", i);
+            m_trackers.at(i).render(m_batchResults[i]);
+        }
+    }
+    if (m_latencyEnabled) {
+        recordLatency(LatencyStage::Render, latencyNow() - start);
+        // The repaint these overlays requested completes the move
+        if (m_activeBatchInputNs != 0) {
+            m_paintInputNs = m_activeBatchInputNs;
+        }
     }
+    m_activeBatchInputNs = 0;
 }
 
 void ZoomAndScroll::updateXLimits(const QChart *chart) {
+    TRACKPLOT_TRACE_SPAN("updateXLimits");
     if (!chart->series().isEmpty()) {
         qreal x_Min = std::numeric_limits<qreal>::infinity();
         qreal x_Max = -std::numeric_limits<qreal>::infinity();
@@ -101,6 +547,16 @@ void ZoomAndScroll::updateXLimits(const QChart *chart) {
             if (!xy || !xy->isVisible())
                 continue;
 
+            if (m_dataBounds.contains(s)) {
+                const QRectF known = m_dataBounds.value(s);
+                hasData = true;
+                x_Min = std::min(x_Min, known.left());
+                x_Max = std::max(x_Max, known.right());
+                y_Min = std::min(y_Min, known.top());
+                y_Max = std::max(y_Max, known.bottom());
+                continue;
+            }
+
             const auto pts = xy->points();
             if (pts.isEmpty())
                 continue;
@@ -145,7 +601,30 @@ void ZoomAndScroll::updateXLimits(const QChart *chart) {
     }
 }
 
+SeriesSnapshot ZoomAndScroll::seriesSnapshot(const QXYSeries *series) const {
+    const qsizetype slot = m_trackedSeries.indexOf(const_cast<QXYSeries *>(series));
+    if (slot >= 0 && m_trackers[slot].snapshot) {
+        return m_trackers[slot].snapshot();
+    }
+    return {series->name(), series->points(), {}, nullptr};
+}
+
+void ZoomAndScroll::setDataBounds(const QAbstractSeries *series, const QRectF &bounds) {
+    if (!m_dataBounds.contains(series)) {
+        connect(series, &QObject::destroyed, this, [this, series]() { m_dataBounds.remove(series); });
+    }
+    m_dataBounds.insert(series, bounds);
+}
+
+void ZoomAndScroll::clearDataBounds(const QAbstractSeries *series) {
+    if (m_dataBounds.remove(series)) {
+        disconnect(series, &QObject::destroyed, this, nullptr);
+    }
+}
+
 void ZoomAndScroll::rangeUpdate() {
+    TRACKPLOT_TRACE_SPAN("rangeUpdate");
+    const ViewLimits previous = viewLimits();
     // Get the X axis
     for (QAbstractAxis *axis: chart()->axes(Qt::Horizontal)) {
         if (const auto *xAxis = qobject_cast<QValueAxis *>(axis)) {
@@ -154,6 +633,12 @@ void ZoomAndScroll::rangeUpdate() {
             break;
         }
     }
+    // Decimated series follow the visible x range (and prefetch the next ones)
+    m_prefetcher->viewChanged(xMin, xMax, chart()->plotArea().width());
+    // Linked views follow this one (coalesced by the group, once per frame)
+    if (m_linkGroup && !m_applyingLinkedRange) {
+        m_linkGroup->requestXRange(this, xMin, xMax);
+    }
 
     // Get the Y axis
     for (QAbstractAxis *axis: chart()->axes((Qt::Vertical))) {
@@ -163,9 +648,30 @@ void ZoomAndScroll::rangeUpdate() {
             break;
         }
     }
+    if (!sameLimits(previous, viewLimits())) {
+        emit viewChanged(viewLimits());
+    }
+}
+
+void ZoomAndScroll::applyLinkedXRange(const qreal min, const qreal max) {
+    TRACKPLOT_TRACE_SPAN("applyLinkedXRange");
+    // Range set by the link group: refresh the cache without echoing it back
+    for (QAbstractAxis *axis: chart()->axes(Qt::Horizontal)) {
+        if (auto *xAxis = qobject_cast<QValueAxis *>(axis)) {
+            if (toggleState) {
+                hideTrackers();
+            }
+            m_applyingLinkedRange = true;
+            xAxis->setRange(min, max);
+            rangeUpdate();
+            m_applyingLinkedRange = false;
+            break;
+        }
+    }
 }
 
 void ZoomAndScroll::resetChartToOriginal() const {
+    TRACKPLOT_TRACE_SPAN("resetChartToOriginal");
     const auto hAxes = chart()->axes(Qt::Horizontal);
     const auto vAxes = chart()->axes(Qt::Vertical);
     auto *xAxis = hAxes.isEmpty() ? nullptr : dynamic_cast<QValueAxis *>(hAxes.first());
@@ -180,7 +686,156 @@ void ZoomAndScroll::resetChartToOriginal() const {
     chart()->update(); // Chart view refreshing
 }
 
+void ZoomAndScroll::setHistoryDepth(const int entries) {
+    m_historyDepth = std::max(1, entries);
+    while (m_history.size() > m_historyDepth) {
+        m_historyCache.remove(m_history.first().id);
+        m_history.removeFirst();
+        --m_historyIndex;
+    }
+    m_historyIndex = std::max<qsizetype>(m_historyIndex, m_history.isEmpty() ? -1 : 0);
+}
+
+void ZoomAndScroll::setHistoryCacheLimit(const qsizetype bytes) {
+    m_historyCache.setMaxCost(std::max<qsizetype>(0, bytes / 1024)); // Evicts LRU entries
+}
+
+qsizetype ZoomAndScroll::historyCacheLimit() const {
+    return m_historyCache.maxCost() * 1024;
+}
+
+bool ZoomAndScroll::historyBack() {
+    return goToHistory(m_historyIndex - 1);
+}
+
+bool ZoomAndScroll::historyForward() {
+    return goToHistory(m_historyIndex + 1);
+}
+
+void ZoomAndScroll::clearHistory() {
+    m_history.clear();
+    m_historyIndex = -1;
+    m_historyCache.clear();
+}
+
+void ZoomAndScroll::beginHistoryGesture() {
+    m_lastWheelCommit.invalidate();
+    // First gesture: the view it starts from becomes the first entry
+    if (m_history.isEmpty()) {
+        m_history.append({viewLimits(), m_nextHistoryId++});
+        m_historyIndex = 0;
+    }
+    cacheHistorySnapshot();
+}
+
+void ZoomAndScroll::beginPendingGesture() {
+    if (m_historyGesturePending) {
+        m_historyGesturePending = false;
+        beginHistoryGesture();
+    }
+}
+
+void ZoomAndScroll::commitHistory(const bool replaceTop) {
+    const ViewLimits limits = viewLimits();
+    if (m_historyIndex >= 0 && sameLimits(m_history[m_historyIndex].limits, limits))
+        return;
+
+    // Successive wheel steps make up a single entry
+    if (replaceTop && m_historyIndex > 0 && m_historyIndex == m_history.size() - 1) {
+        m_historyCache.remove(m_history[m_historyIndex].id);
+        m_history[m_historyIndex].limits = limits;
+        return;
+    }
+    // A new view drops the forward branch
+    while (m_history.size() > m_historyIndex + 1) {
+        m_historyCache.remove(m_history.last().id);
+        m_history.removeLast();
+    }
+    m_history.append({limits, m_nextHistoryId++});
+    m_historyIndex = m_history.size() - 1;
+    setHistoryDepth(m_historyDepth); // Trim the oldest entries
+}
+
+void ZoomAndScroll::cacheHistorySnapshot() {
+    // Once per entry, and never while a snapshot is still standing in for the plot
+    if (m_historyIndex < 0 || !m_historySnapshot.isNull() || m_historyCache.maxCost() <= 0)
+        return;
+    const quint64 id = m_history[m_historyIndex].id;
+    if (m_historyCache.contains(id))
+        return;
+    if (toggleState) {
+        hideTrackers(); // Overlays are not part of the view state
+    }
+    auto *pixmap = new QPixmap(viewport()->grab());
+    const qsizetype cost = std::max<qsizetype>(
+        1, static_cast<qsizetype>(pixmap->width()) * pixmap->height() * pixmap->depth() / 8 / 1024);
+    m_historyCache.insert(id, pixmap, cost); // Takes ownership (deleted if over the cap)
+}
+
+bool ZoomAndScroll::goToHistory(const qsizetype index) {
+    if (index < 0 || index >= m_history.size() || index == m_historyIndex)
+        return false;
+    if (toggleState) {
+        hideTrackers();
+    }
+    cacheHistorySnapshot(); // The view being left
+
+    m_historyIndex = index;
+    const HistoryEntry &target = m_history[index];
+    const QPixmap *cached = m_historyCache.object(target.id); // Also marks it recently used
+    if (cached && cached->deviceIndependentSize().toSize() == viewport()->size()) {
+        // Show the cached plot now; the ranges are applied once it is on screen
+        m_historySnapshot = *cached;
+        m_pendingHistoryLimits = target.limits;
+        viewport()->update();
+    } else {
+        applyLimits(target.limits);
+    }
+    return true;
+}
+
+void ZoomAndScroll::applyLimits(const ViewLimits &limits) {
+    TRACKPLOT_TRACE_SPAN("applyLimits");
+    for (QAbstractAxis *axis: chart()->axes(Qt::Horizontal)) {
+        if (auto *xAxis = qobject_cast<QValueAxis *>(axis)) {
+            xAxis->setRange(limits.xMin, limits.xMax);
+            break;
+        }
+    }
+    for (QAbstractAxis *axis: chart()->axes(Qt::Vertical)) {
+        if (auto *yAxis = qobject_cast<QValueAxis *>(axis)) {
+            yAxis->setRange(limits.yMin, limits.yMax);
+            break;
+        }
+    }
+    chart()->update(); // Chart view refreshing
+    rangeUpdate();
+}
+
+void ZoomAndScroll::drawForeground(QPainter *painter, const QRectF &rect) {
+    QChartView::drawForeground(painter, rect);
+    if (!m_historySnapshot.isNull()) {
+        painter->save();
+        painter->resetTransform(); // Viewport coordinates
+        painter->drawPixmap(0, 0, m_historySnapshot);
+        painter->restore();
+        // On screen once this paint is flushed: re-render the chart right after
+        if (!m_historyApplyQueued) {
+            m_historyApplyQueued = true;
+            QTimer::singleShot(0, this, [this]() {
+                m_historyApplyQueued = false;
+                m_historySnapshot = QPixmap();
+                applyLimits(m_pendingHistoryLimits);
+            });
+        }
+    }
+    if (m_hudVisible) {
+        drawHud(painter);
+    }
+}
+
 void ZoomAndScroll::keyPressEvent(QKeyEvent *event) {
+    TRACKPLOT_TRACE_SPAN("keyPressEvent");
     // Check if keys are pressed
     if (event->key() == Qt::Key_T) {
         toggleState = !toggleState; // Track-line labeling
@@ -196,9 +851,10 @@ void ZoomAndScroll::keyPressEvent(QKeyEvent *event) {
         // labeling. The already-shown tracking lines/labels/bullets would
         // be hidden instantly whenever this mode is switched.
         if (toggleState) {
-            emit hideWhenMove();
+            hideTrackers();
         }
         toggleFocus = !toggleFocus; // Tooltips on cursor hover
+        m_hasFocusPos = false;
     }
     if (event->key() == Qt::Key_R) {
         resizeHorZoom = !resizeHorZoom; // Horizontal panning (x axis clipping)
@@ -212,9 +868,25 @@ void ZoomAndScroll::keyPressEvent(QKeyEvent *event) {
             resizeHorZoom = !resizeHorZoom; // One axis clipping at a time
         }
     }
+    if (event->key() == Qt::Key_B || event->key() == Qt::Key_Back) {
+        historyBack(); // Previous zoom/pan view
+    }
+    if (event->key() == Qt::Key_F || event->key() == Qt::Key_Forward) {
+        historyForward(); // Next zoom/pan view
+    }
+    if (event->key() == Qt::Key_H) {
+        setLatencyHud(!m_hudVisible); // Frame rate and latency overlay
+    }
 }
 
 void ZoomAndScroll::mousePressEvent(QMouseEvent *event) {
+    TRACKPLOT_TRACE_SPAN("mousePressEvent");
+    // Mouse back/forward buttons walk the zoom history
+    if (event->button() == Qt::BackButton || event->button() == Qt::ForwardButton) {
+        event->accept();
+        event->button() == Qt::BackButton ? historyBack() : historyForward();
+        return;
+    }
     if (chart() && !chart()->series().isEmpty()) {
         // Zoom-in by drag/selection rubber band area
         if (event->button() == Qt::LeftButton) {
@@ -233,6 +905,7 @@ void ZoomAndScroll::mousePressEvent(QMouseEvent *event) {
             setCursor(Qt::ClosedHandCursor);
         }
         rangeUpdate();
+        m_historyGesturePending = true; // A plain click grabs nothing
     }
 }
 
@@ -243,47 +916,54 @@ void ZoomAndScroll::clearRubberBand() {
 }
 
 void ZoomAndScroll::mouseReleaseEvent(QMouseEvent *event) {
+    TRACKPLOT_TRACE_SPAN("mouseReleaseEvent");
     if (chart() && !chart()->series().isEmpty()) {
         if (rubberBandItem) {
             QRectF rubberBandRect(rubberBandStartPos, event->pos());
             rubberBandRect = rubberBandRect.normalized();
             QRectF plotArea = chart()->plotArea();
 
+            clearRubberBand(); // Not part of the grabbed view
             if (rubberBandRect.intersects(plotArea)) {
+                beginPendingGesture(); // The view this zoom starts from
                 chart()->zoomIn(rubberBandRect);
             }
-
-            clearRubberBand();
         }
+        m_historyGesturePending = false;
 
         if (event->button() == Qt::RightButton) {
             setDragMode(NoDrag);
             setCursor(Qt::ArrowCursor); // Reset cursor to default
         }
         rangeUpdate();
+        commitHistory();
     }
 }
 
 void ZoomAndScroll::mouseDoubleClickEvent(QMouseEvent *event) {
+    TRACKPLOT_TRACE_SPAN("mouseDoubleClickEvent");
     if (chart() && !chart()->series().isEmpty()) {
         event->accept();
         // Double-click to fit the chart with original axes ranges.
         if (event->button() == Qt::LeftButton) {
             // -----------------
             if (toggleState) {
-                emit hideWhenMove();
+                hideTrackers();
             }
             // -----------------
             resetChartToOriginal();
         }
         rangeUpdate();
+        commitHistory();
     }
 }
 
 void ZoomAndScroll::wheelEvent(QWheelEvent *event) {
+    TRACKPLOT_TRACE_SPAN("wheelEvent");
+    const qint64 start = m_latencyEnabled ? latencyNow() : 0;
     if (chart() && !chart()->series().isEmpty()) {
         if (toggleState) {
-            emit hideWhenMove();
+            hideTrackers();
         }
         // -----------------
         const QRectF plotArea = chart()->plotArea();
@@ -294,6 +974,12 @@ void ZoomAndScroll::wheelEvent(QWheelEvent *event) {
             event->position().y() > plotArea.y() + plotArea.height())
             return;
 
+        // A burst of wheel steps is one history entry
+        const bool wheelBurst = m_lastWheelCommit.isValid() && m_lastWheelCommit.elapsed() < 300;
+        if (!wheelBurst) {
+            beginHistoryGesture();
+        }
+
         const QPointF mousePos = event->position() - plotArea.topLeft();
         const qreal numDegrees = static_cast<qreal>(event->angleDelta().y()) / 8;
         const qreal factor = numDegrees > 0 ? 1.2 : 0.8; // Zoom in or out
@@ -366,123 +1052,157 @@ void ZoomAndScroll::wheelEvent(QWheelEvent *event) {
         }
         event->accept();
         rangeUpdate();
+        commitHistory(wheelBurst);
+        m_lastWheelCommit.start();
+        if (m_latencyEnabled) {
+            recordLatency(LatencyStage::Wheel, latencyNow() - start);
+            m_paintInputNs = start;
+        }
     }
 }
 
 void ZoomAndScroll::mouseMoveEvent(QMouseEvent *event) {
+    TRACKPLOT_TRACE_SPAN("mouseMoveEvent");
     if (chart() && !chart()->series().isEmpty()) {
-        const auto currentTime = std::chrono::steady_clock::now();
+        event->accept();
+        // Latest event wins: a move still waiting for its frame is simply
+        // overwritten, so the final cursor position is always the one handled.
+        if (m_hasPendingMove) {
+            ++m_droppedMoves;
+        }
+        m_pendingMove = {event->pos(), event->globalPosition(), event->buttons()};
+        m_hasPendingMove = true;
+        if (m_latencyEnabled) {
+            m_moveInputNs = latencyNow();
+        }
 
-        if (std::chrono::duration_cast<std::chrono::milliseconds>
-            (currentTime - lastEventTime).count() < 16) {
-            event->accept();
-            return;
+        // Idle view: join the scheduler's frames (an idle scheduler handles
+        // this move right away); moves arriving later wait for the next tick.
+        if (!m_frameActive) {
+            m_idleTimer->stop();
+            m_frameActive = true;
+            FrameScheduler::instance()->requestFrames(this);
         }
-        lastEventTime = currentTime;
+    }
+}
 
-        // Axis ranges only change on zoom/scroll/reset, so the cached
-        // xMin/xMax/yMin/yMax are refreshed there (and after pan-scroll below)
-        // instead of rescanning the axes on every mouse-move frame.
-        if (rubberBandItem) {
-            // -----------------
-            if (toggleState) {
-                emit hideWhenMove();
-            }
-            // -----------------
-            // Set the area to zoom
-            QRectF rubberBandRect(rubberBandStartPos, event->pos());
-            rubberBandRect = rubberBandRect.normalized();
-            rubberBandItem->setRect(rubberBandRect);
+bool ZoomAndScroll::onFrameTick() {
+    if (!m_hasPendingMove) {
+        m_frameActive = false; // Cursor at rest, no need to keep ticking
+        m_idleTimer->start();
+        m_frameCostNs = 0;
+        return false;
+    }
+    m_hasPendingMove = false;
+    // Everything accumulated since the previous tick is the cost of the previous frame.
+    evaluateFrameCost();
+    m_frameCostNs = 0;
+    if (chart() && !chart()->series().isEmpty()) {
+        QElapsedTimer moveClock;
+        moveClock.start();
+        if (m_latencyEnabled && m_moveInputNs != 0) {
+            recordLatency(LatencyStage::InputQueue, latencyNow() - m_moveInputNs);
+            m_paintInputNs = m_moveInputNs; // Unless a tracking batch takes over
+        }
+        processMouseMove(m_pendingMove);
+        const qint64 moveNs = moveClock.nsecsElapsed();
+        m_frameCostNs += moveNs;
+        if (m_latencyEnabled) {
+            recordLatency(m_pendingMove.buttons & Qt::RightButton ? LatencyStage::Pan : LatencyStage::MoveHandling,
+                          moveNs);
         }
+    }
+    return true;
+}
 
-        if (event->buttons() & Qt::RightButton) {
-            qreal deltaX = -(event->pos().x() - lastMousePos.x());
-            qreal deltaY = (event->pos().y() - lastMousePos.y());
-            constexpr qreal sensitivity = 0.8; // Panning sensitivity factor
-            deltaX *= sensitivity;
-            deltaY *= sensitivity;
+void ZoomAndScroll::processMouseMove(const PendingMove &move) {
+    TRACKPLOT_TRACE_SPAN("processMouseMove");
+    // Axis ranges only change on zoom/scroll/reset, so the cached
+    // xMin/xMax/yMin/yMax are refreshed there (and after pan-scroll below)
+    // instead of rescanning the axes on every mouse-move frame.
+    if (rubberBandItem) {
+        // -----------------
+        if (toggleState) {
+            hideTrackers();
+        }
+        // -----------------
+        // Set the area to zoom
+        QRectF rubberBandRect(rubberBandStartPos, move.pos);
+        rubberBandRect = rubberBandRect.normalized();
+        rubberBandItem->setRect(rubberBandRect);
+    }
 
-            if (std::signbit(deltaX)) {
-                if (xMin <= minX) {
-                    deltaX = 0.00;
-                }
-            }
-            if (!std::signbit(deltaX)) {
-                if (xMax >= maxX) {
-                    deltaX = 0.00;
-                }
-            }
+    if (move.buttons & Qt::RightButton) {
+        qreal deltaX = -(move.pos.x() - lastMousePos.x());
+        qreal deltaY = (move.pos.y() - lastMousePos.y());
+        constexpr qreal sensitivity = 0.8; // Panning sensitivity factor
+        deltaX *= sensitivity;
+        deltaY *= sensitivity;
 
-            if (std::signbit(deltaY)) {
-                if (yMin <= minY) {
-                    deltaY = 0.00;
-                }
+        if (std::signbit(deltaX)) {
+            if (xMin <= minX) {
+                deltaX = 0.00;
             }
-            if (!std::signbit(deltaY)) {
-                if (yMax >= maxY) {
-                    deltaY = 0.00;
-                }
+        }
+        if (!std::signbit(deltaX)) {
+            if (xMax >= maxX) {
+                deltaX = 0.00;
             }
-            chart()->scroll(deltaX, deltaY);
-            event->accept();
-            // Panning changes the axis ranges, so refresh the cached values here.
-            rangeUpdate();
         }
 
-        lastMousePos = event->pos();
-
-        const QPointF mousePos = mapToScene(event->pos());
-        // Mouse position as emitted signal
-        const QVector<qreal> viewLimits{xMin, xMax, yMin, yMax};
-        if (!rubberBandItem) {
-            // The signal drives the synchronous, GUI-thread focus-labeling &
-            // hide the logic in each series.
-            emit mouseMoved(mousePos, event, viewLimits);
-
-            // Line-intersection tracking is computed for all series in one
-            // shared background task.
-            if (toggleState && !toggleFocus) {
-                const QPointF chartPos = chart()->mapToValue(mousePos);
-                const bool isVisible = chartPos.x() >= viewLimits[0] && chartPos.x() <= viewLimits[1]
-                                       && chartPos.y() >= viewLimits[2] && chartPos.y() <= viewLimits[3];
-                if (isVisible) {
-                    runBatchTracking(chartPos, mousePos, viewLimits, toggleFocus);
-                }
+        if (std::signbit(deltaY)) {
+            if (yMin <= minY) {
+                deltaY = 0.00;
             }
         }
-    }
-}
-
-void ZoomAndScroll::updateIntersections(QXYSeries *series, const QPointF &point) {
-    // Removal old intersection point for each series, if it exists
-    for (auto it = currentIntersections.begin(); it != currentIntersections.end();) {
-        if (it->series == series) {
-            it = currentIntersections.erase(it);
-        } else {
-            ++it;
+        if (!std::signbit(deltaY)) {
+            if (yMax >= maxY) {
+                deltaY = 0.00;
+            }
         }
+        if (deltaX != 0 || deltaY != 0) {
+            beginPendingGesture(); // The view this pan starts from
+        }
+        chart()->scroll(deltaX, deltaY);
+        // Panning changes the axis ranges, so refresh the cached values here.
+        rangeUpdate();
     }
 
-    // Adding a new intersection point
-    currentIntersections.append({series, point});
-}
-
-QXYSeries *ZoomAndScroll::findBottomSeries() const {
-    if (currentIntersections.isEmpty()) {
-        return nullptr;
-    }
-
-    // Find series with the lowest Y-axis value
-    QXYSeries *bottomSeries = currentIntersections.first().series;
-    qreal lowestY = currentIntersections.first().point.y();
+    lastMousePos = move.pos;
+
+    const QPointF mousePos = mapToScene(move.pos);
+    // Mouse position as emitted signal
+    const ViewLimits limits = viewLimits();
+    if (!rubberBandItem) {
+        // Shared per-frame state, computed once for every tracked series
+        const QPointF chartPos = chart()->mapToValue(mousePos);
+        const bool isVisible = limits.contains(chartPos);
+
+        if (toggleFocus && isVisible) {
+            dispatchFocus(chartPos, mousePos, move.globalPos); // Labeling by mouse hovering
+        } else if (!(toggleState && isVisible)) {
+            // Neither focus-labeling nor tracking is active for this frame.
+            hideTrackers();
+            if (m_linkGroup) {
+                m_linkGroup->hideTracking(this);
+            }
+        }
 
-    for (const auto &[series, point]: currentIntersections) {
-        if (point.y() < lowestY) {
-            lowestY = point.y();
-            bottomSeries = series;
+        // Line-intersection tracking is computed for all series in one
+        // shared background task (for every linked view, when in a group).
+        if (toggleState && !toggleFocus && isVisible) {
+            // Its first visible result is the rendered batch
+            if (m_latencyEnabled) {
+                m_batchInputNs = std::exchange(m_paintInputNs, 0);
+            }
+            if (m_linkGroup) {
+                m_linkGroup->track(this, chartPos, mousePos);
+            } else {
+                runBatchTracking(chartPos, mousePos, limits, toggleFocus);
+            }
         }
+        emit mouseMoved(mousePos, move.globalPos, limits); // Kept for external listeners
     }
-    return bottomSeries;
 }
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -490,31 +1210,12 @@ QXYSeries *ZoomAndScroll::findBottomSeries() const {
 LineSeries::LineSeries(ZoomAndScroll *chartView, QObject *parent)
     : QLineSeries(parent), Methods(this, chartView)
       , m_chartView(chartView) {
-    // Signal/slot to transfer mouse move events to tracking method
-    connect(m_chartView,
-            &ZoomAndScroll::mouseMoved,
-            this,
-            &LineSeries::onMouseMoved,
-            Qt::DirectConnection);
-    // Signal/slot for tracking's hiding effect during mouse events
-    connect(m_chartView,
-            &ZoomAndScroll::hideWhenMove,
-            this,
-            &LineSeries::hideAll,
-            Qt::DirectConnection);
-    // Signal/slot to manage the timed hiding of lines/labels/bullets
-    tooltipTimer = new QTimer(this);
-    connect(tooltipTimer,
-            &QTimer::timeout,
-            this,
-            &LineSeries::hideAll,
-            Qt::DirectConnection);
+    // Mouse moves, hiding and label expiry are dispatched by the view's tracker registry
 }
 
 void LineSeries::hideAll() {
-    if (!m_chartView->currentIntersections.isEmpty()) {
-        m_chartView->currentIntersections.clear();
-    }
+    // Only this series' state: other series keep theirs
+    m_chartView->overlaysHidden(m_slot);
     if (!lines.isEmpty()) {
         for (const auto line: lines) {
             line->hide();
@@ -528,54 +1229,158 @@ void LineSeries::hideAll() {
     }
 }
 
-void LineSeries::onMouseMoved(const QPointF mousePos,
-                              const QMouseEvent *event,
-                              const QVector<qreal> &limits) {
-    const QPointF chartPos = chart()->mapToValue(mousePos);
-    // Visibility checking condition
-    const bool isVisible = chartPos.x() >= limits[0] && chartPos.x() <= limits[1]
-                           && chartPos.y() >= limits[2] && chartPos.y() <= limits[3];
-
-    if (m_chartView->toggleFocus && isVisible) {
-        handleTooltipOnFocus(chartPos, event); // Labeling by mouse hovering
-    } else if (!(m_chartView->toggleState && isVisible)) {
-        // Line-intersection tracking is now driven by the shared batched task in
-        // ZoomAndScroll; only hide it here when neither focus-labeling nor tracking
-        // is active for this frame.
-        hideAll();
-    }
-}
-
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 ScatterSeries::ScatterSeries(ZoomAndScroll *chartView, QObject *parent)
     : QScatterSeries(parent), Methods(this, chartView)
       , m_chartView(chartView) {
-    // Signal/slot to transfer mouse move events to tracking method
-    connect(m_chartView,
-            &ZoomAndScroll::mouseMoved,
-            this,
-            &ScatterSeries::onMouseMoved,
-            Qt::DirectConnection);
-    // Signal/slot for tracking's hiding effect during mouse events
-    connect(m_chartView,
-            &ZoomAndScroll::hideWhenMove,
-            this,
-            &ScatterSeries::hideAll,
-            Qt::DirectConnection);
-    // Signal/slot to manage the timed hiding of labels
-    tooltipTimer = new QTimer(this);
-    connect(tooltipTimer,
-            &QTimer::timeout,
-            this,
-            &ScatterSeries::hideAll,
-            Qt::DirectConnection);
+    // Mouse moves, hiding and label expiry are dispatched by the view's tracker registry
 }
 
-void ScatterSeries::hideAll() {
-    if (!m_chartView->currentIntersections.isEmpty()) {
-        m_chartView->currentIntersections.clear();
+ScatterSeries::~ScatterSeries() {
+    if (m_densityWatcher) {
+        m_densityWatcher->waitForFinished(); // The worker writes into m_densityJob
+    }
+    releaseDensity();
+}
+
+void ScatterSeries::releaseDensity() {
+    if (m_densityItem) {
+        if (m_densityItem->scene()) {
+            m_densityItem->scene()->removeItem(m_densityItem);
+        }
+        delete m_densityItem;
+        m_densityItem = nullptr;
+    }
+}
+
+void ScatterSeries::setDensityData(const QList<QPointF> &points) {
+    m_fullData = points;
+    m_hasFullData = true;
+    if (!m_densityItem) {
+        m_densityItem = new QGraphicsPixmapItem();
+        m_densityItem->hide();
+        m_densityWatcher = new QFutureWatcher<void>(this);
+        connect(m_densityWatcher, &QFutureWatcher<void>::finished, this, &ScatterSeries::onDensityFinished);
+        connect(m_chartView, &ZoomAndScroll::viewChanged, this, &ScatterSeries::updateDensity);
+        connect(m_chartView->chart(), &QChart::plotAreaChanged, this, &ScatterSeries::updateDensity);
+        connect(this, &QXYSeries::visibleChanged, this, [this] {
+            if (m_densityItem) {
+                m_densityItem->setVisible(m_densityActive && isVisible());
+            }
+        });
+    }
+
+    // Until the view has a range, show the extreme samples only, so the
+    // axes and the reset limits still cover the whole cloud
+    QList<QPointF> extremes;
+    if (!points.isEmpty()) {
+        auto [left, right] = std::minmax_element(points.cbegin(), points.cend(),
+                                                 [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); });
+        auto [bottom, top] = std::minmax_element(points.cbegin(), points.cend(),
+                                                 [](const QPointF &a, const QPointF &b) { return a.y() < b.y(); });
+        extremes = {*left, *bottom, *top, *right};
+    }
+    replace(extremes);
+    updateDensity();
+}
+
+void ScatterSeries::setMarkerLimit(const qsizetype points) {
+    m_markerLimit = std::max<qsizetype>(0, points);
+    if (m_densityItem) {
+        updateDensity();
+    }
+}
+
+void ScatterSeries::updateDensity() {
+    if (!m_densityItem) {
+        return;
+    }
+    const ViewLimits limits = m_chartView->viewLimits();
+    const QRectF plot = m_chartView->chart()->plotArea();
+    if (limits.xMax <= limits.xMin || limits.yMax <= limits.yMin || plot.isEmpty()) {
+        return;
+    }
+
+    if (!m_densityItem->scene()) {
+        m_chartView->chart()->scene()->addItem(m_densityItem);
+    }
+    DensityJob job;
+    job.points = m_fullData; // Implicitly shared
+    job.limits = limits;
+    job.width = qCeil(plot.width());
+    job.height = qCeil(plot.height());
+    job.markerLimit = m_markerLimit;
+    if (m_densityWatcher->isRunning()) {
+        m_pendingDensityJob = std::move(job);
+        m_hasPendingDensityJob = true;
+        return;
+    }
+    dispatchDensity(std::move(job));
+}
+
+void ScatterSeries::dispatchDensity(DensityJob job) {
+    m_densityJob = std::move(job);
+    // The worker only reads the job's shared points and writes its results
+    const auto future = QtConcurrent::run([this]() {
+        DensityJob &job = m_densityJob;
+        const ViewLimits &limits = job.limits;
+        job.grid = binDensity(job.points, limits.xMin, limits.xMax, limits.yMin, limits.yMax,
+                              job.width, job.height);
+        job.active = job.grid.total > job.markerLimit;
+        if (job.active) {
+            job.image = densityImage(job.grid);
+        } else {
+            // Few enough to draw: back to individual markers
+            job.grid = {};
+            job.markers = pointsInRange(job.points, limits.xMin, limits.xMax, limits.yMin, limits.yMax);
+        }
+    });
+    m_densityWatcher->setFuture(future);
+}
+
+void ScatterSeries::onDensityFinished() {
+    DensityJob job = std::exchange(m_densityJob, DensityJob{});
+    if (m_hasPendingDensityJob) {
+        m_hasPendingDensityJob = false;
+        dispatchDensity(std::exchange(m_pendingDensityJob, DensityJob{}));
+    }
+    if (!m_densityItem) {
+        return;
+    }
+    // The plot may have moved since: the pixmap follows its top-left corner
+    const QRectF plot = m_chartView->chart()->plotArea();
+    m_density = std::move(job.grid); // Hover reports the bins on screen
+    m_densityActive = job.active;
+    if (m_densityActive) {
+        if (!points().isEmpty()) {
+            replace(QList<QPointF>());
+        }
+        m_densityItem->setPixmap(QPixmap::fromImage(job.image));
+        m_densityItem->setPos(m_chartView->chart()->mapToScene(plot.topLeft()));
+        m_densityItem->setVisible(isVisible());
+    } else {
+        replace(job.markers);
+        m_densityItem->hide();
     }
+}
+
+TrackResult ScatterSeries::densityHit(const HoverQuery &query) const {
+    const quint32 count = m_density.countAt(query.chartPos);
+    if (count == 0) {
+        return {};
+    }
+    TrackResult result;
+    result.pos = m_density.binCenter(query.chartPos);
+    result.IPpixel = query.mousePos;
+    result.isValid = true;
+    result.binCount = count;
+    return result;
+}
+
+void ScatterSeries::hideAll() {
+    // Only this series' state: other series keep theirs
+    m_chartView->overlaysHidden(m_slot);
     if (!lines.isEmpty()) {
         for (const auto line: lines) {
             line->hide();
@@ -589,53 +1394,17 @@ void ScatterSeries::hideAll() {
     }
 }
 
-void ScatterSeries::onMouseMoved(const QPointF mousePos,
-                                 const QMouseEvent *event,
-                                 const QVector<qreal> &limits) {
-    const QPointF chartPos = chart()->mapToValue(mousePos);
-    // Visibility checking condition
-    const bool isVisible = chartPos.x() >= limits[0] && chartPos.x() <= limits[1]
-                           && chartPos.y() >= limits[2] && chartPos.y() <= limits[3];
-
-    if (m_chartView->toggleFocus && isVisible) {
-        handleTooltipOnFocus(chartPos, event); // Labeling by mouse hovering
-    } else if (!(m_chartView->toggleState && isVisible)) {
-        // Line-intersection tracking is now driven by the shared batched task in
-        // ZoomAndScroll; only hide it here when neither focus-labeling nor tracking
-        // is active for this frame.
-        hideAll();
-    }
-}
-
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 SplineSeries::SplineSeries(ZoomAndScroll *chartView, QObject *parent)
     : QSplineSeries(parent), Methods(this, chartView)
       , m_chartView(chartView) {
-    // Signal/slot to transfer mouse move events to tracking method
-    connect(m_chartView,
-            &ZoomAndScroll::mouseMoved,
-            this,
-            &SplineSeries::onMouseMoved,
-            Qt::DirectConnection);
-    // Signal/slot for tracking's hiding effect during mouse events
-    connect(m_chartView,
-            &ZoomAndScroll::hideWhenMove,
-            this,
-            &SplineSeries::hideAll,
-            Qt::DirectConnection);
-    // Signal/slot to manage the timed hiding of labels
-    tooltipTimer = new QTimer(this);
-    connect(tooltipTimer,
-            &QTimer::timeout,
-            this, &SplineSeries::hideAll,
-            Qt::DirectConnection);
+    // Mouse moves, hiding and label expiry are dispatched by the view's tracker registry
 }
 
 void SplineSeries::hideAll() {
-    if (!m_chartView->currentIntersections.isEmpty()) {
-        m_chartView->currentIntersections.clear();
-    }
+    // Only this series' state: other series keep theirs
+    m_chartView->overlaysHidden(m_slot);
     if (!lines.isEmpty()) {
         for (const auto line: lines) {
             line->hide();
@@ -651,22 +1420,75 @@ void SplineSeries::hideAll() {
     }
 }
 
-void SplineSeries::onMouseMoved(const QPointF mousePos,
-                                const QMouseEvent *event,
-                                const QVector<qreal> &limits) {
-    const QPointF chartPos = chart()->mapToValue(mousePos);
-    // Visibility checking condition
-    const bool isVisible = chartPos.x() >= limits[0] && chartPos.x() <= limits[1]
-                           && chartPos.y() >= limits[2] && chartPos.y() <= limits[3];
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+StepSeries::StepSeries(ZoomAndScroll *chartView, const StepMode mode, QObject *parent)
+    : QLineSeries(parent), Methods(this, chartView)
+      , m_chartView(chartView)
+      , m_mode(mode) {
+    // Mouse moves, hiding and label expiry are dispatched by the view's tracker registry
+}
+
+void StepSeries::hideAll() {
+    // Only this series' state: other series keep theirs
+    m_chartView->overlaysHidden(m_slot);
+    if (!lines.isEmpty()) {
+        for (const auto line: lines) {
+            line->hide();
+        }
+        for (const auto tip: toolTips) {
+            tip->hide();
+        }
+    }
+    if (bullet) {
+        bullet->hide();
+    }
+}
+
+void StepSeries::appendStair(const QPointF &from, const QPointF &to, QList<QPointF> &out) const {
+    // Corner point(s) between two samples, then the new sample itself
+    switch (m_mode) {
+        case StepMode::Before:
+            out.append(QPointF(from.x(), to.y()));
+            break;
+        case StepMode::Center: {
+            const qreal mid = (from.x() + to.x()) / 2;
+            out.append(QPointF(mid, from.y()));
+            out.append(QPointF(mid, to.y()));
+            break;
+        }
+        default:
+            out.append(QPointF(to.x(), from.y()));
+            break;
+    }
+    out.append(to);
+}
 
-    if (m_chartView->toggleFocus && isVisible) {
-        handleTooltipOnFocus(chartPos, event); // Labeling by mouse hovering
-    } else if (!(m_chartView->toggleState && isVisible)) {
-        // Line-intersection tracking is now driven by the shared batched task in
-        // ZoomAndScroll; only hide it here when neither focus-labeling nor tracking
-        // is active for this frame.
-        hideAll();
+void StepSeries::appendSample(const qreal x, const qreal y) {
+    const QPointF sample(x, y);
+    if (m_samples.isEmpty()) {
+        append(sample);
+    } else {
+        QList<QPointF> stair;
+        stair.reserve(3);
+        appendStair(m_samples.last(), sample, stair);
+        append(stair);
     }
+    m_samples.append(sample);
+}
+
+void StepSeries::setSamples(const QList<QPointF> &samples) {
+    m_samples = samples;
+    QList<QPointF> stairs;
+    stairs.reserve(samples.size() * 3);
+    for (qsizetype i = 0; i < samples.size(); ++i) {
+        if (i == 0) {
+            stairs.append(samples.first());
+        } else {
+            appendStair(samples[i - 1], samples[i], stairs);
+        }
+    }
+    replace(stairs);
 }
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -677,28 +1499,89 @@ Methods<SeriesType>::Methods(SeriesType *ptr, ZoomAndScroll *m_chartView)
       ptr(ptr),
       m_chartView(m_chartView) {
     registerBatchTracking();
+    // Follow the view's quality governor
+    QObject::connect(m_chartView, &ZoomAndScroll::qualityChanged, ptr,
+                     [this](const ZoomAndScroll::Quality quality) { applyQuality(quality); });
+    // Points replaced by hand: bounds known from an index no longer apply.
+    // Decimated series are redrawn through replace() on every view change,
+    // their data only changes through the set*Data() calls below.
+    QObject::connect(ptr, &QXYSeries::pointsReplaced, ptr, [this]() {
+        if (!m_hasFullData && this->m_chartView) {
+            this->m_chartView->clearDataBounds(this->ptr);
+        }
+    });
 }
 
 // Single batched task
 template<typename SeriesType>
 void Methods<SeriesType>::registerBatchTracking() {
-    m_chartView->registerTracker(
+    m_slot = m_chartView->registerTracker(qobject_cast<QXYSeries *>(ptr), {
         // prepare (GUI thread): refresh the immutable snapshot only when needed.
         [this]() {
-            if (m_points.size() != ptr->count()) {
-                m_points = ptr->points();
-            }
+            refreshSnapshot();
         },
         // compute (worker thread): pure, reads only the cached snapshot.
         [this](const QPointF &chartPos, const QPointF &mousePos,
-               const QVector<qreal> &limits, const bool focusEnabled) -> TrackResult {
-            const Intercerp r = findIntersection(m_points, focusEnabled, chartPos, mousePos, limits);
+               const ViewLimits &limits, const bool focusEnabled) -> TrackResult {
+            Intercerp r;
+            if (m_trackedBlocks) {
+                r = findIntersection(*m_trackedBlocks, focusEnabled, chartPos, mousePos, limits, m_batchHint);
+            } else if (!m_trackedSamples.isEmpty()) {
+                r = findIntersection(m_trackedSamples, focusEnabled, chartPos, mousePos, limits, m_batchHint);
+            } else {
+                r = findIntersection(m_points, focusEnabled, chartPos, mousePos, limits, m_batchHint);
+            }
             return TrackResult{r.distance, r.pos, r.IPpixel, r.isValid};
         },
         // render (GUI thread): draw lines/labels/bullet for this series.
         [this](const TrackResult &result) {
             renderTracking(result);
-        });
+        },
+        // focus (GUI thread): hover hit-test, the view shows the nearest hit.
+        [this](const HoverQuery &query) {
+            return handleTooltipOnFocus(query);
+        },
+        // hide (GUI thread): lines/labels/bullet.
+        [this]() {
+            ptr->hideAll();
+        },
+        // snapshot (GUI thread): the full data, whatever its storage.
+        [this]() {
+            SeriesSnapshot snapshot{ptr->name(), {}, m_compactData,
+                                    m_blockData ? m_blockData->snapshot() : nullptr};
+            if constexpr (requires { ptr->samples(); }) {
+                snapshot.points = ptr->samples();
+            } else if (m_hasFullData) {
+                snapshot.points = m_fullData;
+            } else {
+                snapshot.points = ptr->points();
+            }
+            return snapshot;
+        },
+        // detach (GUI thread): the view is being destroyed, its scene still holds the overlays.
+        [this]() {
+            releaseOverlays();
+            if constexpr (requires { ptr->releaseDensity(); }) {
+                ptr->releaseDensity();
+            }
+            m_chartView = nullptr;
+        }
+    });
+}
+
+template<typename SeriesType>
+void Methods<SeriesType>::applyQuality(const ZoomAndScroll::Quality quality) {
+    m_linearTracking.store(quality >= ZoomAndScroll::Quality::LinearTracking, std::memory_order_relaxed);
+    for (const auto effect: shadowEffect) {
+        effect->setEnabled(quality < ZoomAndScroll::Quality::NoShadows);
+    }
+    if (quality >= ZoomAndScroll::Quality::NoLabels) {
+        hideTooltip();
+    } else if (bullet && bullet->isVisible()) {
+        // Labels are back while the overlays are still up: show them now,
+        // not on the next move
+        setTooltips(m_lastIntersection, m_chartView->chart()->mapToPosition(m_lastIntersection));
+    }
 }
 
 template<typename SeriesType>
@@ -714,8 +1597,7 @@ void Methods<SeriesType>::deleteTooltip() {
 }
 
 template<typename SeriesType>
-Methods<SeriesType>::~Methods() {
-    ptr->hideTooltip(); // Hide before destruction
+void Methods<SeriesType>::releaseOverlays() {
     deleteTooltip(); // Correct deallocation memory order (no double deallocation)
     qDeleteAll(lines); // Track-lines
     lines.clear();
@@ -725,213 +1607,277 @@ Methods<SeriesType>::~Methods() {
     }
 }
 
-// Labeling by mouse hovering
 template<typename SeriesType>
-void Methods<SeriesType>::handleTooltipOnFocus(const QPointF &chartPos, const QMouseEvent *event) {
-    QVector<qreal> limits = {m_chartView->xMin, m_chartView->xMax, m_chartView->yMin, m_chartView->yMax};
-    // Runs on the GUI thread; reuse the cached one-time snapshot of the points.
-    if (m_points.size() != ptr->count()) {
-        m_points = ptr->points();
-    }
-    Intercerp intersection = findIntersection(m_points, m_chartView->toggleFocus, chartPos, event->pos(), limits);
-    // The Tooltip is displayed only if it is within a threshold distance
-    // Get the X axis range for normalization
-    qreal xRange = m_chartView->maxX - m_chartView->minX;
-    qreal relativeThreshold = 0.001; // 0.1% of the total range
-
-    if (intersection.isValid && xRange > std::numeric_limits<qreal>::epsilon() &&
-        intersection.distance / xRange < relativeThreshold) {
-        if (!intersection.pos.isNull()) {
-            const QString tooltipText = QString("X: %1, Y: %2")
-                    .arg(intersection.pos.x(), 0, 'f', 2)
-                    .arg(intersection.pos.y(), 0, 'f', 2);
-
-            QToolTip::showText(event->globalPosition().toPoint(), tooltipText);
-            tooltipTimer->start(m_tooltipTimeout);
-        }
-    } else {
-        QToolTip::hideText(); // Hides the previous tooltip immediately
+Methods<SeriesType>::~Methods() {
+    if (m_chartView) {
+        // Not detached: the view is still alive
+        ptr->hideTooltip(); // Hide before destruction
+        m_chartView->unregisterTracker(m_slot); // No callback is left pointing at this series
     }
+    releaseOverlays();
 }
 
+// Labeling by mouse hovering: hit-test only, the view shows the tooltip
 template<typename SeriesType>
-Methods<SeriesType>::Intercerp
-Methods<SeriesType>::findIntersection(const QList<QPointF> &points, const bool focusEnabled,
-                                      const QPointF &chartPos, const QPointF &mousePos,
-                                      const QVector<qreal> &limits) {
-    // On GUI-thread snapshot, no race condition in worker thread.
-    if (points.size() < 2) {
+TrackResult Methods<SeriesType>::handleTooltipOnFocus(const HoverQuery &query) {
+    // Density display: the bin under the cursor is the hit
+    if constexpr (requires { ptr->densityHit(query); }) {
+        if (ptr->densityActive()) {
+            return ptr->densityHit(query);
+        }
+    }
+    // Runs on the GUI thread, once per frame, on its own copy of the tracked
+    // data: the worker's snapshot is left alone, so nothing waits for it.
+    trackedPoints(m_focusPoints);
+    refreshSegments();
+    const qsizetype count = m_segmentSource.size();
+    if (count < 2 || query.scaleX <= 0 || query.scaleY <= 0) {
         return {};
     }
 
-    const qreal mouseX = chartPos.x();
-    const int pointCount = static_cast<int>(points.size());
-
-    int left = 0;
-    int right = pointCount - 1;
-    const bool ascending = points.first().x() < points.last().x();
-
-    while (left < right) {
-        const int mid = left + (right - left) / 2;
-        if (ascending) {
-            if (points[mid].x() < mouseX) {
-                left = mid + 1;
-            } else {
-                right = mid;
-            }
-        } else {
-            if (points[mid].x() > mouseX) {
-                left = mid + 1;
-            } else {
-                right = mid;
-            }
-        }
+    // Candidate window: every segment within the radius along x
+    const QPointF *points = m_segmentSource.constData();
+    const qreal halfWidth = query.radius / query.scaleX;
+    const qsizetype from = lowerBoundX(points, count, query.chartPos.x() - halfWidth,
+                                       std::max<qsizetype>(0, m_hoverHint));
+    const qsizetype to = lowerBoundX(points, count, query.chartPos.x() + halfWidth, from);
+    qsizetype first = std::max<qsizetype>(0, std::min(from, to) - 1);
+    qsizetype last = std::min(count - 1, std::max(from, to) + 1);
+    if (last - first > maxHoverSegments) {
+        // Zoomed far out: keep the segments closest to the cursor's x
+        const qsizetype center = lowerBoundX(points, count, query.chartPos.x(), from);
+        first = std::max(first, center - maxHoverSegments / 2);
+        last = std::min(last, first + maxHoverSegments);
     }
+    m_hoverHint = first;
+    loadSegmentWindow(first, last);
 
-    const int idx = std::max(0, left - 1);
-    if (idx + 1 >= pointCount) {
+    const SegmentQuery segmentQuery{query.chartPos.x(), query.chartPos.y(), query.scaleX, query.scaleY};
+    const NearestSegment nearest = nearestSegment(m_segmentXs.constData(), m_segmentYs.constData(),
+                                                  0, last - first, segmentQuery);
+    if (nearest.index < 0) {
         return {};
     }
+    const qreal distance = std::sqrt(nearest.distanceSquared);
+    if (distance > query.radius) {
+        return {};
+    }
+
+    // Report the series value (its own interpolation) at the nearest point's x
+    const qsizetype i = nearest.index; // Within the window
+    const QPointF closest(m_segmentXs[i] + nearest.t * (m_segmentXs[i + 1] - m_segmentXs[i]),
+                          m_segmentYs[i] + nearest.t * (m_segmentYs[i + 1] - m_segmentYs[i]));
+    // Compact and block data are read live: they only change on this thread
+    const SegmentHit hit = ptr->withInterpolation([&](auto policy) {
+        if (m_blockData) {
+            return trackSegment<decltype(policy)>(*m_blockData, closest, false, m_focusHint);
+        }
+        if (!m_compactData.isEmpty()) {
+            return trackSegment<decltype(policy)>(m_compactData, closest, false, m_focusHint);
+        }
+        return trackSegment<decltype(policy)>(m_focusPoints.constData(), m_focusPoints.size(), closest, false,
+                                              m_focusHint);
+    });
+    return TrackResult{distance, hit.isValid ? hit.pos : closest, query.mousePos, true};
+}
 
-    const QPointF &p1 = points[idx];
-    const QPointF &p2 = points[idx + 1];
+template<typename SeriesType>
+void Methods<SeriesType>::refreshSegments() {
+    // Hover tests what is drawn: the stairs for step series, the decimated
+    // points for decimated series, the tracked points otherwise
+    QList<QPointF> drawn = m_focusPoints;
+    if (m_hasFullData) {
+        drawn = ptr->points();
+    }
+    if constexpr (requires { ptr->samples(); }) {
+        drawn = ptr->points();
+    }
+    // Holding the source keeps its buffer alive, so an unchanged address means unchanged data
+    if (drawn.constData() == m_segmentSource.constData() && drawn.size() == m_segmentSource.size()) {
+        return;
+    }
+    m_segmentSource = drawn;
+    m_segmentFirst = m_segmentLast = -1; // The loaded window is stale
+    m_hoverHint = -1;
+}
 
-    const qreal minX = std::min(p1.x(), p2.x());
-    const qreal maxX = std::max(p1.x(), p2.x());
+template<typename SeriesType>
+void Methods<SeriesType>::loadSegmentWindow(const qsizetype first, const qsizetype last) {
+    // Only the candidate window goes to structure-of-arrays, O(window) on the
+    // GUI thread; a cursor at rest keeps the one already loaded
+    if (first == m_segmentFirst && last == m_segmentLast) {
+        return;
+    }
+    const QPointF *points = m_segmentSource.constData();
+    const qsizetype n = last - first + 1;
+    m_segmentXs.resize(n);
+    m_segmentYs.resize(n);
+    for (qsizetype i = 0; i < n; ++i) {
+        m_segmentXs[i] = points[first + i].x();
+        m_segmentYs[i] = points[first + i].y();
+    }
+    m_segmentFirst = first;
+    m_segmentLast = last;
+}
 
-    if (mouseX < minX || mouseX > maxX) {
+template<typename SeriesType>
+template<typename Samples>
+Methods<SeriesType>::Intercerp
+Methods<SeriesType>::findIntersection(const Samples &points, const bool focusEnabled,
+                                      const QPointF &chartPos, const QPointF &mousePos,
+                                      const ViewLimits &, qsizetype &hint) {
+    // On GUI-thread snapshot, no race condition in worker thread.
+    // One shared search loop, instantiated per interpolation policy.
+    const SegmentHit hit = ptr->withInterpolation([&](auto policy) {
+        if constexpr (!std::is_same_v<Samples, QList<QPointF>>) {
+            // Compact or block storage, decoded in place
+            return trackSegment<decltype(policy)>(points, chartPos, focusEnabled, hint);
+        } else {
+            return trackSegment<decltype(policy)>(points.constData(), points.size(), chartPos, focusEnabled, hint);
+        }
+    });
+    if (!hit.isValid) {
         return {};
     }
 
     Intercerp result;
+    result.distance = hit.distance;
+    result.pos = hit.pos;
     result.IPpixel = mousePos;
+    result.isValid = true;
+    return result;
+}
 
-    const qreal dx = p2.x() - p1.x();
-    if (std::abs(dx) > std::numeric_limits<qreal>::epsilon()) {
-        const qreal t = (mouseX - p1.x()) / dx;
-        result.pos = QPointF(mouseX, p1.y() + t * (p2.y() - p1.y()));
-        result.isValid = true;
-        if (focusEnabled) {
-            result.distance = distanceToLineSegment(chartPos, p1, p2);
-        }
-        return result;
+template<typename SeriesType>
+void Methods<SeriesType>::setDecimatedData(const QList<QPointF> &points, const DatasetIndex *index) {
+    if constexpr (requires { ptr->samples(); }) {
+        ptr->setSamples(points);
+    } else {
+        m_fullData = points;
+        m_hasFullData = true;
+        m_compactData = {};
+        m_blockData = nullptr;
+        m_chartView->prefetcher()->setSource(m_slot, ptr, points, index);
+    }
+    // Once the points are in place (replacing them clears the bounds)
+    if (index && index->isValid() && index->count() == points.size()) {
+        m_chartView->setDataBounds(ptr, index->bounds());
+    } else {
+        m_chartView->clearDataBounds(ptr);
     }
-    return {};
 }
 
 template<typename SeriesType>
-void Methods<SeriesType>::renderTracking(const TrackResult &result) {
-    if (!result.isValid) {
-        ptr->hideAll();
-        return;
+void Methods<SeriesType>::setCompactData(const CompactSamples &samples) {
+    m_chartView->clearDataBounds(ptr);
+    if constexpr (requires { ptr->samples(); }) {
+        ptr->setSamples(samples.mid(0, samples.size()));
+    } else {
+        m_fullData = {};
+        m_hasFullData = true;
+        m_compactData = samples;
+        m_blockData = nullptr;
+        m_chartView->prefetcher()->setSource(m_slot, ptr, samples);
     }
+}
 
-    const QPointF intersectionPoint = result.pos;
-    const QPointF mousePos = result.IPpixel; // IPpixel stores mousePos in background task
-
-    const QPointF IPpixel = m_chartView->chart()->mapToPosition(intersectionPoint);
+template<typename SeriesType>
+void Methods<SeriesType>::setBlockData(const BlockStore *store) {
+    m_chartView->clearDataBounds(ptr);
+    if constexpr (requires { ptr->samples(); }) {
+        ptr->setSamples(store->mid(0, store->size()));
+    } else {
+        if (!m_blockData) {
+            // Redraw on every view change (connected once; no-op once replaced)
+            QObject::connect(m_chartView, &ZoomAndScroll::viewChanged, ptr, [this]() { displayBlocks(); });
+            QObject::connect(m_chartView->chart(), &QChart::plotAreaChanged, ptr, [this]() { displayBlocks(); });
+        }
+        m_fullData = {};
+        m_compactData = {};
+        m_hasFullData = true;
+        m_blockData = store;
+        m_chartView->prefetcher()->removeSource(m_slot);
+        displayBlocks();
+    }
+}
 
-    QVector<qreal> limits = {m_chartView->xMin, m_chartView->xMax, m_chartView->yMin, m_chartView->yMax};
+template<typename SeriesType>
+void Methods<SeriesType>::blockDataAppended() {
+    if constexpr (!requires { ptr->samples(); }) {
+        displayBlocks();
+    }
+}
 
-    if (!intersectionPoint.isNull() &&
-        intersectionPoint.x() >= limits[0] && intersectionPoint.x() <= limits[1] &&
-        intersectionPoint.y() >= limits[2] && intersectionPoint.y() <= limits[3]) {
-        // Storing intersection point for further comparison
-        m_chartView->updateIntersections(qobject_cast<QXYSeries *>(ptr), intersectionPoint);
-        //
-        updateVerticalLine(mousePos, IPpixel, limits); // Draw tracking lines
-        setTooltips(intersectionPoint, IPpixel); // Creates the labels
-        drawBullet(intersectionPoint); // Draw the bullet at the intersection
+template<typename SeriesType>
+void Methods<SeriesType>::displayBlocks() {
+    if (!m_blockData) {
+        return;
+    }
+    const ViewLimits limits = m_chartView->viewLimits();
+    if (limits.xMax > limits.xMin) {
+        const int columns = std::max(1, qRound(m_chartView->chart()->plotArea().width()));
+        ptr->replace(m_blockData->view(limits.xMin, limits.xMax, columns));
     } else {
-        m_chartView->updateIntersections(qobject_cast<QXYSeries *>(ptr), QPointF());
-        ptr->hideAll();
+        // Not laid out yet: the whole recording, mostly from the summaries
+        const QRectF bounds = m_blockData->bounds();
+        ptr->replace(m_blockData->view(bounds.left(), bounds.right(), 2048));
     }
 }
 
-Methods<SplineSeries>::Intercerp
-SplineSeries::findIntersection(const QList<QPointF> &points, const bool focusEnabled,
-                               const QPointF &chartPos, const QPointF &mousePos,
-                               const QVector<qreal> &limits) {
-    // On GUI-thread snapshot, no race condition in worker thread.
-    const int pointCount = static_cast<int>(points.size());
-    // Check if there are enough points
-    if (pointCount < 2) {
-        return {};
+template<typename SeriesType>
+void Methods<SeriesType>::trackedPoints(QList<QPointF> &points) const {
+    if constexpr (requires { ptr->samples(); }) {
+        // Step series track their raw samples, not the stairs they draw
+        points = ptr->samples(); // Implicitly shared, O(1)
+    } else if (m_hasFullData) {
+        points = m_fullData; // Decimated display: track the full data
+    } else if (points.size() != ptr->count()) {
+        points = ptr->points();
     }
+}
 
-    // Binary search to find the closest index point
-    const qreal mouseX = chartPos.x();
-    int left = 0;
-    int right = pointCount - 1;
-    bool ascending = points.first().x() < points.last().x();
-    //
-    while (left < right) {
-        const int mid = left + (right - left) / 2;
-        if (ascending) {
-            if (points[mid].x() < mouseX) {
-                left = mid + 1;
-            } else {
-                right = mid;
-            }
-        } else {
-            if (points[mid].x() > mouseX) {
-                left = mid + 1;
-            } else {
-                right = mid;
-            }
+template<typename SeriesType>
+void Methods<SeriesType>::refreshSnapshot() {
+    trackedPoints(m_points);
+    if (m_hasFullData) {
+        m_trackedSamples = m_compactData; // Or its compact form (implicitly shared)
+        // Or an immutable snapshot of its block store, taken again once the
+        // store grew or was replaced: appends never race with the worker
+        if (!m_blockData) {
+            m_trackedBlocks.reset();
+            m_trackedBlocksSource = nullptr;
+        } else if (m_trackedBlocksSource != m_blockData || m_trackedBlocks->size() != m_blockData->size()) {
+            m_trackedBlocks = m_blockData->snapshot();
+            m_trackedBlocksSource = m_blockData;
         }
     }
+}
 
-    // Check having a valid segment
-    const int idx = std::max(0, left - 1);
-    if (idx + 1 >= pointCount) {
-        return {};
+template<typename SeriesType>
+void Methods<SeriesType>::renderTracking(const TrackResult &result) {
+    if (!result.isValid) {
+        ptr->hideAll();
+        return;
     }
 
-    // Get segment points
-    const QPointF &p1 = points[idx];
-    const QPointF &p2 = points[idx + 1];
-
-    // Quick bounds check
-    const qreal minX = std::min(p1.x(), p2.x());
-    const qreal maxX = std::max(p1.x(), p2.x());
+    const QPointF intersectionPoint = result.pos;
+    const QPointF mousePos = result.IPpixel; // IPpixel stores mousePos in background task
 
-    if (mouseX < minX || mouseX > maxX) {
-        return {};
-    }
+    const QPointF IPpixel = m_chartView->chart()->mapToPosition(intersectionPoint);
 
-    Intercerp result;
-    result.IPpixel = mousePos;
+    const ViewLimits limits = m_chartView->viewLimits();
 
-    // Calculate interpolation
-    const qreal dx = p2.x() - p1.x();
-    // Check division by zero
-    if (std::abs(dx) > std::numeric_limits<qreal>::epsilon()) {
-        QPointF interpolated;
-        const qreal t = (mouseX - p1.x()) / dx;
-        // Use Catmull-Rom if there are enough points
-        if (idx > 0 && idx < pointCount - 2) {
-            const QPointF &p0 = points[idx - 1];
-            const QPointF &p3 = points[idx + 2];
-            interpolated = catmullRomInterpolate(t, p0, p1, p2, p3);
-        } else {
-            // Fall back to linear interpolation for edge segments
-            interpolated = QPointF(
-                mouseX,
-                p1.y() + t * (p2.y() - p1.y())
-            );
-        }
-
-        result.pos = interpolated;
-        result.isValid = true;
-        if (focusEnabled) {
-            // Only calculate distance if needed
-            result.distance = distanceToLineSegment(chartPos, p1, interpolated);
+    if (!intersectionPoint.isNull() && limits.contains(intersectionPoint)) {
+        m_chartView->overlaysShown(m_slot);
+        m_lastIntersection = intersectionPoint;
+        updateVerticalLine(mousePos, IPpixel, limits); // Draw tracking lines
+        if (m_chartView->quality() < ZoomAndScroll::Quality::NoLabels) {
+            setTooltips(intersectionPoint, IPpixel); // Creates the labels
         }
-        return result;
+        drawBullet(intersectionPoint); // Draw the bullet at the intersection
+    } else {
+        ptr->hideAll();
     }
-    // Return an empty object if no intersection found
-    return {};
 }
 
 // Distance calculation from a point to a line segment
@@ -939,32 +1885,7 @@ template<typename SeriesType>
 qreal Methods<SeriesType>::distanceToLineSegment(const QPointF &point,
                                                  const QPointF &lineStart,
                                                  const QPointF &lineEnd) {
-    // Cache coordinate differences
-    const qreal dx = lineEnd.x() - lineStart.x();
-    const qreal dy = lineEnd.y() - lineStart.y();
-
-    // Check for a degenerate case (point segment)
-    const qreal lengthSquared = dx * dx + dy * dy;
-    if (lengthSquared < std::numeric_limits<qreal>::epsilon()) {
-        // Point-to-point distance calculation
-        const qreal px = point.x() - lineStart.x();
-        const qreal py = point.y() - lineStart.y();
-        return std::sqrt(px * px + py * py);
-    }
-
-    // Calculate projection parameter
-    const qreal px = point.x() - lineStart.x();
-    const qreal py = point.y() - lineStart.y();
-    const qreal t = std::clamp((px * dx + py * dy) / lengthSquared, 0.0, 1.0);
-
-    // Calculate the closest point on a line segment
-    const qreal projX = lineStart.x() + t * dx;
-    const qreal projY = lineStart.y() + t * dy;
-
-    // Calculate distance
-    const qreal distX = point.x() - projX;
-    const qreal distY = point.y() - projY;
-    return std::sqrt(distX * distX + distY * distY);
+    return segmentDistance(point, lineStart, lineEnd);
 }
 
 template<typename SeriesType>
@@ -979,13 +1900,12 @@ void Methods<SeriesType>::createLines(int n) {
 template<typename SeriesType>
 void Methods<SeriesType>::updateVerticalLine(
     // Update track-lines position
-    const QPointF &mousePos, const QPointF &IPpixel, const QVector<qreal> &limits) {
+    const QPointF &mousePos, const QPointF &IPpixel, const ViewLimits &limits) {
     if (!m_chartView) return;
     m_chartView->setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
     // --------
     QPointF chartPos = m_chartView->chart()->mapToValue(mousePos);
-    if (chartPos.x() >= limits[0] && chartPos.x() <= limits[1] && chartPos.y() >= limits[2] &&
-        chartPos.y() <= limits[3]) {
+    if (limits.contains(chartPos)) {
         if (lines.isEmpty()) {
             createLines(2);
             lines[0]->setPen(QPen(Qt::blue, 1, Qt::DashLine));
@@ -1000,10 +1920,8 @@ void Methods<SeriesType>::updateVerticalLine(
         // Track-line type switch: Crosshair | truncated
         if (m_chartView->toggleLines) {
             // Only show vertical track line belonging to the bottom-most placed series
-            auto currentSeries = qobject_cast<QXYSeries *>(ptr);
-            auto bottomSeries = m_chartView->findBottomSeries();
-            //
-            if (bottomSeries == currentSeries) {
+            // (resolved once per batch by the view)
+            if (m_chartView->bottomSlot() == m_slot) {
                 lines[0]->setLine(mousePos.x(),
                                   IPpixel.y(),
                                   mousePos.x(),
@@ -1034,60 +1952,82 @@ void Methods<SeriesType>::updateVerticalLine(
 }
 
 template<typename SeriesType>
-void Methods<SeriesType>::createTooltips(const QList<TooltipData> &tooltipDataList) {
-    const qsizetype n = tooltipDataList.size();
+void Methods<SeriesType>::createTooltips(const std::span<const TooltipData> tooltipDataList) {
+    const auto n = static_cast<qsizetype>(tooltipDataList.size());
     if (toolTips.size() < n) {
+        const qsizetype first = toolTips.size();
         toolTips.resize(n);
-        // Create QList of QLabels
-        std::generate_n(toolTips.begin() + toolTips.size() - n, n, [this]() {
-            return new QLabel(m_chartView);
-        });
-        // Create QList of QGraphicsDropShadowEffect
         shadowEffect.resize(n);
-        std::generate_n(shadowEffect.begin() + shadowEffect.size() - n, n, [this]() {
-            return new QGraphicsDropShadowEffect(m_chartView);
-        });
-        // Set a font for each label
-        for (const auto tip: toolTips) {
-            QFont font = tip->font();
-            font.setBold(true);
-            tip->setFont(font);
-        }
-        // Create a shadow effect for each label
-        for (const auto effect: shadowEffect) {
+        m_labelState.resize(n);
+        m_labelText.resize(n);
+        // Static label styling is applied once, at creation; restyling every
+        // frame would re-polish and relayout each label.
+        for (qsizetype i = first; i < n; ++i) {
+            // Shadow effect for the label
+            auto *effect = new QGraphicsDropShadowEffect(m_chartView);
             effect->setBlurRadius(10);
             effect->setXOffset(5);
             effect->setYOffset(5);
             effect->setColor(Qt::gray);
+            effect->setEnabled(m_chartView->quality() < ZoomAndScroll::Quality::NoShadows);
+
+            auto *tip = new QLabel(m_chartView);
+            QFont font = tip->font();
+            font.setBold(true);
+            tip->setFont(font);
+            tip->setStyleSheet("border: 1.2px solid black; border-radius: 3px; padding: 3px;");
+            tip->setLineWidth(10);
+            tip->setAutoFillBackground(true);
+            tip->setGraphicsEffect(effect);
+            tip->setAttribute(Qt::WA_TransparentForMouseEvents);
+            tip->setWindowFlags(Qt::FramelessWindowHint);
+            tip->setWordWrap(true);
+            tip->setMinimumSize(QSize(80, 20));
+            tip->setAlignment(Qt::AlignCenter);
+
+            toolTips[i] = tip;
+            shadowEffect[i] = effect;
+            for (QString &buffer: m_labelText[i].buffers) {
+                buffer.reserve(std::tuple_size_v<decltype(TooltipData::text)>);
+            }
         }
     }
 
+    // Per frame, only what actually changed is pushed to each label
     for (qsizetype i = 0; i < n; ++i) {
-        const auto &[text, position, color] = tooltipDataList[i];
-
-        // Palette setup
-        QPalette palette;
-        palette.setColor(QPalette::Window, color);
-        palette.setColor(QPalette::WindowText, QColor(255, 255, 255)); // White text
-
-        toolTips[i]->setStyleSheet("border: 1.2px solid black; border-radius: 3px; padding: 3px;");
-        toolTips[i]->setLineWidth(10);
-        toolTips[i]->setAutoFillBackground(true);
-        toolTips[i]->setPalette(palette);
-        toolTips[i]->setGraphicsEffect(shadowEffect[i]);
-        toolTips[i]->setAttribute(Qt::WA_TransparentForMouseEvents);
-        toolTips[i]->setWindowFlags(Qt::FramelessWindowHint);
-        toolTips[i]->setText(text);
-        toolTips[i]->setWordWrap(true);
-        toolTips[i]->setMinimumSize(QSize(80, 20));
-        toolTips[i]->setAlignment(Qt::AlignCenter);
-        toolTips[i]->move(position);
-        toolTips[i]->raise();
-        toolTips[i]->show();
+        const TooltipData &wanted = tooltipDataList[i];
+        TooltipData &shown = m_labelState[i];
+        QLabel *tip = toolTips[i];
+
+        if (wanted.color != shown.color) {
+            // Palette setup
+            QPalette palette;
+            palette.setColor(QPalette::Window, wanted.color);
+            palette.setColor(QPalette::WindowText, QColor(255, 255, 255)); // White text
+            tip->setPalette(palette);
+            shown.color = wanted.color;
+        }
+        if (wanted.length != shown.length ||
+            !std::equal(wanted.text.begin(), wanted.text.begin() + wanted.length, shown.text.begin())) {
+            LabelText &label = m_labelText[i];
+            QString &next = label.buffers[1 - label.shown];
+            next.resize(wanted.length); // Within the reserved capacity
+            std::transform(wanted.text.begin(), wanted.text.begin() + wanted.length, next.begin(),
+                           [](const char c) { return QChar(QLatin1Char(c)); });
+            tip->setText(next);
+            label.shown = 1 - label.shown;
+            shown.text = wanted.text;
+            shown.length = wanted.length;
+        }
+        if (wanted.position != shown.position) {
+            tip->move(wanted.position);
+            shown.position = wanted.position;
+        }
+        if (tip->isHidden()) {
+            tip->raise();
+            tip->show();
+        }
     }
-
-    // Start or restart the custom tooltip (label) timer
-    tooltipTimer->start(m_tooltipTimeout); // Hide all
 }
 
 template<typename SeriesType>
@@ -1095,33 +2035,33 @@ void Methods<SeriesType>::setTooltips(const QPointF &intersectionPoint, const QP
     // Cast IPpixel to QPoint
     const QPoint IPcd(static_cast<int>(IPpixel.x()), static_cast<int>(IPpixel.y()));
     //
-    QList<TooltipData> tooltipDataList;
     // Create data for tooltips
     const auto IP = QPoint(IPcd.x() + 5, IPcd.y() + 5);
     const auto xLabel = QPoint(IPcd.x(), static_cast<int>(m_chartView->chart()->plotArea().top()) - 25);
     const auto yLabel = QPoint(static_cast<int>(m_chartView->chart()->plotArea().left()) - 60, IPcd.y());
-    const QString tooltipText = QString("X: %1\nY: %2")
-            .arg(intersectionPoint.x(), 0, 'f', 2)
-            .arg(intersectionPoint.y(), 0, 'f', 2);
-
-    // x axis label text
-    const QString tooltipTextx = QString("X: %1").arg(intersectionPoint.x(), 0, 'f', 2);
-    // y axis label text
-    const QString tooltipTexty = QString("Y: %1").arg(intersectionPoint.y(), 0, 'f', 2);
 
     const auto *series = qobject_cast<SeriesType *>(ptr);
     const QColor colorSerie = series->pen().color();
 
+    // Fill the reused label slots in place (no per-frame list)
+    auto &[xTip, yTip, ipTip] = m_tooltipData;
     //------- x custom tooltip
-    tooltipDataList.append({tooltipTextx, xLabel, Qt::black});
+    xTip.length = LabelWriter(xTip.text).text("X: ").number(intersectionPoint.x()).length();
+    xTip.position = xLabel;
+    xTip.color = Qt::black;
     //------- y custom tooltip
-    tooltipDataList.append({tooltipTexty, yLabel, colorSerie});
+    yTip.length = LabelWriter(yTip.text).text("Y: ").number(intersectionPoint.y()).length();
+    yTip.position = yLabel;
+    yTip.color = colorSerie;
     //------- Intersection-point custom tooltip
-    tooltipDataList.append({tooltipText, IP, colorSerie});
+    ipTip.length = LabelWriter(ipTip.text).text("X: ").number(intersectionPoint.x())
+            .text("\nY: ").number(intersectionPoint.y()).length();
+    ipTip.position = IP;
+    ipTip.color = colorSerie;
     //-------
 
     // Create or update the tooltips
-    createTooltips(tooltipDataList);
+    createTooltips(m_tooltipData);
 }
 
 template<typename SeriesType>
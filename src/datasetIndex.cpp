@@ -0,0 +1,324 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "datasetIndex.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cstring>
+#include <limits>
+
+struct DatasetIndex::Header {
+    char magic[4];
+    quint32 version;
+    quint8 key[32];
+    qint64 count;
+    quint32 flags;
+    quint32 levels;
+    qreal bounds[4]; // xMin, yMin, xMax, yMax
+    qint64 levelOffset[maxLevels];
+    qint64 levelBuckets[maxLevels];
+    qint64 prefixOffset; // Level-0 bucket count + 1 sums
+};
+
+namespace {
+    constexpr char magic[4] = {'T', 'P', 'I', 'X'};
+    constexpr quint32 ascendingFlag = 1;
+
+    // Keys of any length are stored as 32 bytes
+    QByteArray fixedKey(const QByteArray &key) {
+        if (key.size() == 32) {
+            return key;
+        }
+        return QCryptographicHash::hash(key, QCryptographicHash::Blake2b_256);
+    }
+
+    void merge(DatasetIndex::Bucket &into, const DatasetIndex::Bucket &other) {
+        into.xLast = other.xLast;
+        if (other.minPoint.y() < into.minPoint.y())
+            into.minPoint = other.minPoint;
+        if (other.maxPoint.y() > into.maxPoint.y())
+            into.maxPoint = other.maxPoint;
+    }
+}
+
+DatasetIndex::DatasetIndex() = default;
+
+DatasetIndex::~DatasetIndex() {
+    unmap();
+}
+
+QByteArray DatasetIndex::sampledKey(const QList<QPointF> &points) {
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    const qint64 count = points.size();
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(&count), sizeof(count)));
+    if (count <= keySamples) {
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(points.constData()),
+                                    points.size() * static_cast<qsizetype>(sizeof(QPointF))));
+        return hash.result();
+    }
+    // Evenly spaced, first and last included
+    for (qsizetype k = 0; k < keySamples; ++k) {
+        const QPointF &p = points[static_cast<qsizetype>(k * (count - 1) / (keySamples - 1))];
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&p), sizeof(QPointF)));
+    }
+    return hash.result();
+}
+
+QByteArray DatasetIndex::fileKey(const QString &dataPath, const QList<QPointF> &points) {
+    const QFileInfo info(dataPath);
+    const QString path = info.canonicalFilePath().isEmpty() ? info.absoluteFilePath() : info.canonicalFilePath();
+    const qint64 identity[2] = {info.size(), info.lastModified().toMSecsSinceEpoch()};
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    hash.addData(path.toUtf8());
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(identity), sizeof(identity)));
+    hash.addData(sampledKey(points));
+    return hash.result();
+}
+
+QByteArray DatasetIndex::contentKey(const QList<QPointF> &points) {
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(points.constData()),
+                                points.size() * static_cast<qsizetype>(sizeof(QPointF))));
+    return hash.result();
+}
+
+bool DatasetIndex::open(const QString &sidecarPath, const QList<QPointF> &points, const QByteArray &key) {
+    const QByteArray dataKey = key.isEmpty() ? sampledKey(points) : key;
+    if (load(sidecarPath, dataKey)) {
+        return true;
+    }
+    build(points, dataKey);
+    save(sidecarPath); // A read-only location only costs the rebuild next time
+    return isValid();
+}
+
+bool DatasetIndex::load(const QString &sidecarPath, const QByteArray &key) {
+    unmap();
+    m_file.setFileName(sidecarPath);
+    if (!m_file.open(QIODevice::ReadOnly) || m_file.size() < static_cast<qint64>(sizeof(Header))) {
+        m_file.close();
+        return false;
+    }
+    m_mapped = m_file.map(0, m_file.size());
+    if (!m_mapped) {
+        m_file.close();
+        return false;
+    }
+
+    // Validate before use: the sidecar may be stale, truncated or foreign
+    Header h{};
+    std::memcpy(&h, m_mapped, sizeof(Header));
+    const QByteArray expected = fixedKey(key);
+    const qint64 size = m_file.size();
+    bool valid = std::memcmp(h.magic, magic, sizeof(magic)) == 0 && h.version == formatVersion &&
+                 std::memcmp(h.key, expected.constData(), sizeof(h.key)) == 0 &&
+                 h.count >= 0 && h.levels <= maxLevels;
+    for (quint32 l = 0; valid && l < h.levels; ++l) {
+        valid = h.levelOffset[l] >= static_cast<qint64>(sizeof(Header)) && h.levelBuckets[l] >= 0 &&
+                h.levelOffset[l] + h.levelBuckets[l] * static_cast<qint64>(sizeof(Bucket)) <= size;
+    }
+    const qint64 prefixCount = h.levels > 0 ? h.levelBuckets[0] + 1 : 1;
+    valid = valid && h.prefixOffset >= static_cast<qint64>(sizeof(Header)) &&
+            h.prefixOffset + prefixCount * static_cast<qint64>(sizeof(qreal)) <= size;
+    if (!valid) {
+        unmap();
+        return false;
+    }
+    m_data = m_mapped;
+    m_size = size;
+    return true;
+}
+
+void DatasetIndex::build(const QList<QPointF> &points, const QByteArray &key) {
+    unmap();
+    const qint64 count = points.size();
+
+    // Level 0: one bucket per baseBucketSamples samples; each level merges pairs
+    QList<QList<Bucket>> pyramid(1);
+    QList<qreal> prefix(1, 0);
+    bool ascending = true;
+    qreal xMin = std::numeric_limits<qreal>::max();
+    qreal xMax = std::numeric_limits<qreal>::lowest();
+    for (qint64 first = 0; first < count; first += baseBucketSamples) {
+        const qint64 last = std::min(count, first + baseBucketSamples);
+        Bucket bucket{points[first].x(), points[last - 1].x(), points[first], points[first]};
+        qreal sum = 0;
+        for (qint64 i = first; i < last; ++i) {
+            const QPointF &p = points[i];
+            if (i > 0 && !(points[i - 1].x() < p.x()))
+                ascending = false;
+            xMin = std::min(xMin, p.x());
+            xMax = std::max(xMax, p.x());
+            if (p.y() < bucket.minPoint.y())
+                bucket.minPoint = p;
+            if (p.y() > bucket.maxPoint.y())
+                bucket.maxPoint = p;
+            sum += p.y();
+        }
+        pyramid[0].append(bucket);
+        prefix.append(prefix.last() + sum);
+    }
+    while (pyramid.last().size() > 1 && pyramid.size() < maxLevels) {
+        const QList<Bucket> &below = pyramid.last();
+        QList<Bucket> above;
+        above.reserve((below.size() + 1) / 2);
+        for (qsizetype i = 0; i < below.size(); i += 2) {
+            Bucket bucket = below[i];
+            if (i + 1 < below.size()) {
+                merge(bucket, below[i + 1]);
+            }
+            above.append(bucket);
+        }
+        pyramid.append(above);
+    }
+
+    Header h{};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version = formatVersion;
+    std::memcpy(h.key, fixedKey(key).constData(), sizeof(h.key));
+    h.count = count;
+    h.flags = ascending ? ascendingFlag : 0;
+    h.levels = count > 0 ? static_cast<quint32>(pyramid.size()) : 0;
+    if (count > 0) {
+        const Bucket &top = pyramid.last().first();
+        h.bounds[0] = xMin;
+        h.bounds[1] = top.minPoint.y();
+        h.bounds[2] = xMax;
+        h.bounds[3] = top.maxPoint.y();
+    }
+    qint64 offset = sizeof(Header);
+    for (quint32 l = 0; l < h.levels; ++l) {
+        h.levelOffset[l] = offset;
+        h.levelBuckets[l] = pyramid[l].size();
+        offset += pyramid[l].size() * static_cast<qint64>(sizeof(Bucket));
+    }
+    h.prefixOffset = offset;
+    offset += prefix.size() * static_cast<qint64>(sizeof(qreal));
+
+    m_built = QByteArray(offset, Qt::Uninitialized);
+    char *out = m_built.data();
+    std::memcpy(out, &h, sizeof(Header));
+    for (quint32 l = 0; l < h.levels; ++l) {
+        std::memcpy(out + h.levelOffset[l], pyramid[l].constData(), pyramid[l].size() * sizeof(Bucket));
+    }
+    std::memcpy(out + h.prefixOffset, prefix.constData(), prefix.size() * sizeof(qreal));
+    m_data = reinterpret_cast<const uchar *>(m_built.constData());
+    m_size = offset;
+}
+
+bool DatasetIndex::save(const QString &sidecarPath) const {
+    if (!isValid()) {
+        return false;
+    }
+    QSaveFile file(sidecarPath); // Atomic: readers never map a half-written sidecar
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(m_data), m_size);
+    return file.commit();
+}
+
+const DatasetIndex::Header &DatasetIndex::header() const {
+    return *reinterpret_cast<const Header *>(m_data);
+}
+
+qint64 DatasetIndex::count() const {
+    return isValid() ? header().count : 0;
+}
+
+bool DatasetIndex::ascending() const {
+    return isValid() && (header().flags & ascendingFlag) != 0;
+}
+
+QRectF DatasetIndex::bounds() const {
+    if (count() == 0) {
+        return {};
+    }
+    const Header &h = header();
+    return {QPointF(h.bounds[0], h.bounds[1]), QPointF(h.bounds[2], h.bounds[3])};
+}
+
+int DatasetIndex::levels() const {
+    return isValid() ? static_cast<int>(header().levels) : 0;
+}
+
+std::span<const DatasetIndex::Bucket> DatasetIndex::level(const int level) const {
+    if (level < 0 || level >= levels()) {
+        return {};
+    }
+    const Header &h = header();
+    return {reinterpret_cast<const Bucket *>(m_data + h.levelOffset[level]),
+            static_cast<std::size_t>(h.levelBuckets[level])};
+}
+
+qreal DatasetIndex::bucketSum(const qint64 first, const qint64 last) const {
+    if (levels() == 0 || first >= last) {
+        return 0;
+    }
+    const Header &h = header();
+    const auto *prefix = reinterpret_cast<const qreal *>(m_data + h.prefixOffset);
+    const qint64 buckets = h.levelBuckets[0];
+    return prefix[std::clamp<qint64>(last, 0, buckets)] - prefix[std::clamp<qint64>(first, 0, buckets)];
+}
+
+QList<QPointF> DatasetIndex::overview(const qreal xMin, const qreal xMax, const int columns) const {
+    QList<QPointF> outline;
+    if (!ascending() || levels() == 0 || columns <= 0 || xMax <= xMin) {
+        return outline;
+    }
+    // Coarsest level whose buckets are not wider than a column (on average)
+    const qreal width = (xMax - xMin) / columns;
+    const qreal span = bounds().width();
+    int l = 0;
+    while (l + 1 < levels() && span / static_cast<qreal>(level(l + 1).size()) <= width) {
+        ++l;
+    }
+    const std::span<const Bucket> buckets = level(l);
+    auto byFirstX = [](const qreal x, const Bucket &b) { return x < b.xFirst; };
+    const auto begin = std::upper_bound(buckets.begin(), buckets.end(), xMin, byFirstX);
+    const auto end = std::upper_bound(buckets.begin(), buckets.end(), xMax, byFirstX);
+    const qsizetype first = std::max<qsizetype>(0, begin - buckets.begin() - 2);
+    const qsizetype last = std::min<qsizetype>(static_cast<qsizetype>(buckets.size()), end - buckets.begin() + 1);
+    outline.reserve(2 * (last - first));
+    for (qsizetype i = first; i < last; ++i) {
+        const Bucket &b = buckets[i];
+        const bool minFirst = b.minPoint.x() <= b.maxPoint.x();
+        outline.append(minFirst ? b.minPoint : b.maxPoint);
+        if (b.minPoint != b.maxPoint) {
+            outline.append(minFirst ? b.maxPoint : b.minPoint);
+        }
+    }
+    return outline;
+}
+
+void DatasetIndex::unmap() {
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_built.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
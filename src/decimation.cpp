@@ -0,0 +1,181 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "decimation.h"
+#include "compactSamples.h"
+#include "trackKernels.h"
+#include <cmath>
+#include <limits>
+
+qreal DecimationGrid::columnWidth(const int level) const {
+    return std::ldexp(baseWidth, level);
+}
+
+qint64 DecimationGrid::tileAt(const int level, const qreal x) const {
+    return static_cast<qint64>(std::floor((x - x0) / tileWidth(level)));
+}
+
+int DecimationGrid::levelFor(const qreal wantedColumnWidth) const {
+    if (!isValid() || wantedColumnWidth <= baseWidth) {
+        return 0;
+    }
+    return static_cast<int>(std::floor(std::log2(wantedColumnWidth / baseWidth)));
+}
+
+DecimationGrid DecimationGrid::forPoints(const QList<QPointF> &points) {
+    // Tiles rely on binary searches, so only ascending x is decimated
+    if (points.size() < 2 || !(points.first().x() < points.last().x())) {
+        return {};
+    }
+    return {points.first().x(), (points.last().x() - points.first().x()) / baseColumns};
+}
+
+DecimationGrid DecimationGrid::forSamples(const CompactSamples &samples) {
+    const QRectF bounds = samples.bounds();
+    if (samples.size() < 2 || !(bounds.left() < bounds.right())) {
+        return {};
+    }
+    return {bounds.left(), bounds.width() / baseColumns};
+}
+
+void VisibleStats::merge(const VisibleStats &other) {
+    if (other.count == 0)
+        return;
+    yMin = count > 0 ? std::min(yMin, other.yMin) : other.yMin;
+    yMax = count > 0 ? std::max(yMax, other.yMax) : other.yMax;
+    count += other.count;
+    sum += other.sum;
+}
+
+namespace {
+    // QPointF samples behind the same accessor interface as CompactSamples
+    struct PointSamples {
+        const QPointF *points = nullptr;
+        qsizetype count = 0;
+
+        [[nodiscard]] qsizetype size() const { return count; }
+
+        [[nodiscard]] qreal x(const qsizetype i) const { return points[i].x(); }
+
+        [[nodiscard]] qreal y(const qsizetype i) const { return points[i].y(); }
+
+        [[nodiscard]] const QPointF &at(const qsizetype i) const { return points[i]; }
+
+        [[nodiscard]] qsizetype lowerBound(const qreal value) const {
+            return lowerBoundX<true>(points, 0, count - 1, value);
+        }
+    };
+
+    // One kernel for every storage: instantiated per accessor, no per-sample dispatch
+    template<typename Samples>
+    DecimationTile decimateSamples(const Samples &samples, const DecimationGrid &grid, const int level,
+                                   const qint64 tileIndex) {
+        DecimationTile tile;
+        const qsizetype count = samples.size();
+        if (count < 1 || !grid.isValid()) {
+            return tile;
+        }
+        const qreal width = grid.columnWidth(level);
+        const qreal start = grid.x0 + static_cast<qreal>(tileIndex) * grid.tileWidth(level);
+        const qreal end = start + grid.tileWidth(level);
+
+        qsizetype i = samples.lowerBound(start);
+        if (samples.x(i) < start) {
+            return tile; // Tile after the last sample
+        }
+        tile.points.reserve(2 * DecimationGrid::tileColumns);
+
+        // One pass: min and max index of each column, flushed when the column changes
+        qint64 column = -1;
+        qsizetype minIndex = -1;
+        qsizetype maxIndex = -1;
+        qreal minY{};
+        qreal maxY{};
+        // Tile statistics, kept in locals and merged once: the extremes come
+        // from the column ones, only the sum is per sample
+        const qsizetype first = i;
+        qreal tileMin = std::numeric_limits<qreal>::infinity();
+        qreal tileMax = -std::numeric_limits<qreal>::infinity();
+        qreal sum = 0;
+        auto flush = [&]() {
+            if (column < 0)
+                return;
+            tileMin = std::min(tileMin, minY);
+            tileMax = std::max(tileMax, maxY);
+            const qsizetype a = std::min(minIndex, maxIndex);
+            const qsizetype b = std::max(minIndex, maxIndex);
+            tile.points.append(samples.at(a));
+            if (b != a) {
+                tile.points.append(samples.at(b));
+            }
+        };
+        for (; i < count; ++i) {
+            const qreal x = samples.x(i);
+            if (x >= end)
+                break;
+            const qreal y = samples.y(i);
+            const auto c = std::min<qint64>(DecimationGrid::tileColumns - 1,
+                                            static_cast<qint64>((x - start) / width));
+            if (c != column) {
+                flush();
+                column = c;
+                minIndex = maxIndex = i;
+                minY = maxY = y;
+            } else {
+                if (y < minY) {
+                    minIndex = i;
+                    minY = y;
+                }
+                if (y > maxY) {
+                    maxIndex = i;
+                    maxY = y;
+                }
+            }
+            sum += y;
+        }
+        flush();
+        tile.stats.merge({i - first, tileMin, tileMax, sum});
+        return tile;
+    }
+}
+
+DecimationTile decimateTile(const QPointF *points, const qsizetype count, const DecimationGrid &grid,
+                            const int level, const qint64 tileIndex) {
+    return decimateSamples(PointSamples{points, count}, grid, level, tileIndex);
+}
+
+DecimationTile decimateTile(const CompactSamples &samples, const DecimationGrid &grid, const int level,
+                            const qint64 tileIndex) {
+    return samples.visit([&](const auto &access) { return decimateSamples(access, grid, level, tileIndex); });
+}
+
+QList<QPointF> decimateOverview(const QList<QPointF> &points, const int columns) {
+    const DecimationGrid grid = DecimationGrid::forPoints(points);
+    if (!grid.isValid() || points.size() <= 4 * static_cast<qsizetype>(columns)) {
+        return points;
+    }
+    const int level = grid.levelFor((points.last().x() - grid.x0) / columns);
+    QList<QPointF> overview;
+    const qint64 lastTile = grid.tileAt(level, points.last().x());
+    for (qint64 t = 0; t <= lastTile; ++t) {
+        overview.append(decimateTile(points.constData(), points.size(), grid, level, t).points);
+    }
+    return overview;
+}
@@ -0,0 +1,158 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "densityGrid.h"
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
+#include <array>
+#include <cmath>
+
+namespace {
+    constexpr qsizetype minPointsPerWorker = 1 << 16;
+    constexpr int maxWorkers = 8; // Each worker owns a full-size partial histogram
+    constexpr int indexBlock = 256;
+
+    struct BinChunk {
+        const QPointF *points = nullptr;
+        qsizetype count = 0;
+        QList<quint32> counts;
+    };
+
+    // Viridis-like stops, from sparse to dense
+    constexpr std::array<QRgb, 5> colorStops{
+        0xff440154, 0xff3b528b, 0xff21918c, 0xff5ec962, 0xfffde725
+    };
+
+    QRgb colorAt(const qreal t) {
+        const qreal scaled = std::clamp(t, 0.0, 1.0) * (colorStops.size() - 1);
+        const auto i = std::min<qsizetype>(static_cast<qsizetype>(scaled), colorStops.size() - 2);
+        const qreal f = scaled - static_cast<qreal>(i);
+        auto mix = [f](const int a, const int b) { return static_cast<int>(a + (b - a) * f); };
+        const QRgb a = colorStops[i];
+        const QRgb b = colorStops[i + 1];
+        return qRgba(mix(qRed(a), qRed(b)), mix(qGreen(a), qGreen(b)), mix(qBlue(a), qBlue(b)), 220);
+    }
+}
+
+quint32 DensityGrid::countAt(const QPointF &value) const {
+    if (isEmpty())
+        return 0;
+    const auto col = static_cast<int>(std::floor((value.x() - xMin) / (xMax - xMin) * width));
+    const auto row = static_cast<int>(std::floor((yMax - value.y()) / (yMax - yMin) * height));
+    if (col < 0 || col >= width || row < 0 || row >= height)
+        return 0;
+    return counts[static_cast<qsizetype>(row) * width + col];
+}
+
+QPointF DensityGrid::binCenter(const QPointF &value) const {
+    const qreal binWidth = (xMax - xMin) / width;
+    const qreal binHeight = (yMax - yMin) / height;
+    return {xMin + (std::floor((value.x() - xMin) / binWidth) + 0.5) * binWidth,
+            yMax - (std::floor((yMax - value.y()) / binHeight) + 0.5) * binHeight};
+}
+
+DensityGrid binDensity(const QList<QPointF> &points, const qreal xMin, const qreal xMax, const qreal yMin,
+                       const qreal yMax, const int width, const int height) {
+    DensityGrid grid{xMin, xMax, yMin, yMax, width, height, {}, 0, 0};
+    if (width <= 0 || height <= 0 || xMax <= xMin || yMax <= yMin) {
+        return grid;
+    }
+    const qsizetype bins = static_cast<qsizetype>(width) * height;
+
+    // Contiguous chunks, one partial histogram each (no shared counters)
+    const qsizetype count = points.size();
+    const int workers = static_cast<int>(std::clamp<qsizetype>(
+        count / minPointsPerWorker, 1, std::min(maxWorkers, QThread::idealThreadCount())));
+    QList<BinChunk> chunks(workers);
+    for (int w = 0; w < workers; ++w) {
+        const qsizetype from = count * w / workers;
+        const qsizetype to = count * (w + 1) / workers;
+        chunks[w].points = points.constData() + from;
+        chunks[w].count = to - from;
+    }
+
+    const qreal sx = width / (xMax - xMin);
+    const qreal sy = height / (yMax - yMin);
+    QtConcurrent::blockingMap(chunks, [&](BinChunk &chunk) {
+        chunk.counts = QList<quint32>(bins, 0);
+        quint32 *counts = chunk.counts.data();
+        std::array<qsizetype, indexBlock> index{};
+        for (qsizetype base = 0; base < chunk.count; base += indexBlock) {
+            const qsizetype n = std::min<qsizetype>(indexBlock, chunk.count - base);
+            const QPointF *p = chunk.points + base;
+            // Branch-free bin indices (-1: outside the range)
+            for (qsizetype k = 0; k < n; ++k) {
+                const qreal cx = (p[k].x() - xMin) * sx;
+                const qreal cy = (yMax - p[k].y()) * sy;
+                const bool inside = cx >= 0 && cx < width && cy >= 0 && cy < height;
+                index[k] = inside ? static_cast<qsizetype>(cy) * width + static_cast<qsizetype>(cx) : -1;
+            }
+            for (qsizetype k = 0; k < n; ++k) {
+                if (index[k] >= 0) {
+                    ++counts[index[k]];
+                }
+            }
+        }
+    });
+
+    // Reduce into the first partial histogram
+    grid.counts = std::move(chunks[0].counts);
+    quint32 *total = grid.counts.data();
+    for (int w = 1; w < workers; ++w) {
+        const quint32 *partial = chunks[w].counts.constData();
+        for (qsizetype i = 0; i < bins; ++i) {
+            total[i] += partial[i];
+        }
+    }
+    for (qsizetype i = 0; i < bins; ++i) {
+        grid.maxCount = std::max(grid.maxCount, total[i]);
+        grid.total += total[i];
+    }
+    return grid;
+}
+
+QImage densityImage(const DensityGrid &grid) {
+    if (grid.isEmpty()) {
+        return {};
+    }
+    QImage image(grid.width, grid.height, QImage::Format_ARGB32_Premultiplied);
+    const qreal scale = 1.0 / std::log1p(static_cast<qreal>(std::max<quint32>(1, grid.maxCount)));
+    for (int row = 0; row < grid.height; ++row) {
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(row));
+        const quint32 *counts = grid.counts.constData() + static_cast<qsizetype>(row) * grid.width;
+        for (int col = 0; col < grid.width; ++col) {
+            line[col] = counts[col] == 0
+                            ? qRgba(0, 0, 0, 0)
+                            : qPremultiply(colorAt(std::log1p(static_cast<qreal>(counts[col])) * scale));
+        }
+    }
+    return image;
+}
+
+QList<QPointF> pointsInRange(const QList<QPointF> &points, const qreal xMin, const qreal xMax, const qreal yMin,
+                             const qreal yMax) {
+    QList<QPointF> visible;
+    for (const QPointF &p: points) {
+        if (p.x() >= xMin && p.x() <= xMax && p.y() >= yMin && p.y() <= yMax) {
+            visible.append(p);
+        }
+    }
+    return visible;
+}
@@ -0,0 +1,303 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "frameScheduler.h"
+#include "customEvents.h"
+#include "traceRecorder.h"
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QThread>
+#include <QWindow>
+
+namespace {
+    // Posted by the worker once its batch is computed; Qt owns it and
+    // deletes it after delivery (or with the scheduler, if still queued).
+    class BatchDoneEvent final : public QEvent {
+    public:
+        BatchDoneEvent() : QEvent(eventType()) {
+        }
+
+        static Type eventType() {
+            static const auto type = static_cast<Type>(registerEventType());
+            return type;
+        }
+    };
+
+    // Hidden (e.g. on a hidden tab), minimized or fully covered window:
+    // nothing to draw. Checked on every frame, so it uses the window's
+    // exposure rather than visibleRegion(), which builds a QRegion per call.
+    bool drawable(const QWidget *view) {
+        if (!view->isVisible()) {
+            return false;
+        }
+        const QWindow *window = view->window()->windowHandle();
+        return window && window->isExposed();
+    }
+}
+
+FrameScheduler *FrameScheduler::instance() {
+    static QPointer<FrameScheduler> scheduler;
+    if (!scheduler) {
+        scheduler = new FrameScheduler(QCoreApplication::instance());
+    }
+    return scheduler;
+}
+
+FrameScheduler::FrameScheduler(QObject *parent)
+    : QObject(parent) {
+    // The only frame clock; it only runs while some view or task has work.
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, [this]() { tick(); });
+}
+
+FrameScheduler::~FrameScheduler() {
+    if (m_worker) {
+        {
+            QMutexLocker lock(&m_workerMutex);
+            m_stopWorker = true;
+            m_workerWake.wakeAll();
+        }
+        m_worker->wait(); // Finishes the batch in flight first
+        delete m_worker;
+    }
+}
+
+void FrameScheduler::registerView(ZoomAndScroll *view) {
+    m_views.append({view, Priority::Normal, false});
+    sortViews();
+}
+
+void FrameScheduler::unregisterView(ZoomAndScroll *view) {
+    // The worker reads the view's callbacks and buffers in place
+    waitForBatch();
+    m_views.removeIf([view](const ViewEntry &entry) { return entry.view == view; });
+    m_batchViews.removeOne(view);
+}
+
+void FrameScheduler::setPriority(ZoomAndScroll *view, const Priority priority) {
+    for (ViewEntry &entry: m_views) {
+        if (entry.view == view) {
+            entry.priority = priority;
+            break;
+        }
+    }
+    sortViews();
+    // Work left pending while the view was idle is picked up again
+    if (priority != Priority::Idle && view->m_frameActive) {
+        requestFrames(view);
+    }
+}
+
+FrameScheduler::Priority FrameScheduler::priority(const ZoomAndScroll *view) const {
+    for (const ViewEntry &entry: m_views) {
+        if (entry.view == view) {
+            return entry.priority;
+        }
+    }
+    return Priority::Normal;
+}
+
+void FrameScheduler::requestFrames(ZoomAndScroll *view) {
+    for (ViewEntry &entry: m_views) {
+        if (entry.view == view) {
+            entry.active = true;
+            break;
+        }
+    }
+    ensureTicking();
+}
+
+void FrameScheduler::post(QObject *owner, std::function<void()> task) {
+    for (Task &pending: m_tasks) {
+        if (pending.owner == owner) {
+            pending.run = std::move(task); // Latest wins
+            return;
+        }
+    }
+    m_tasks.append({owner, std::move(task)});
+    ensureTicking();
+}
+
+void FrameScheduler::setFrameInterval(const int msec) {
+    m_frameInterval = std::max(0, msec);
+    if (m_timer->isActive()) {
+        m_timer->setInterval(frameInterval());
+    }
+}
+
+int FrameScheduler::frameInterval() const {
+    if (m_frameInterval > 0) {
+        return m_frameInterval;
+    }
+    // Follow the refresh rate of the primary screen (60 Hz fallback)
+    const QScreen *s = QGuiApplication::primaryScreen();
+    const qreal hz = s && s->refreshRate() > 0 ? s->refreshRate() : 60.0;
+    return std::max(1, qRound(1000.0 / hz));
+}
+
+void FrameScheduler::waitForBatch() const {
+    QMutexLocker lock(&m_workerMutex);
+    while (m_batchQueued) {
+        m_batchDone.wait(&m_workerMutex);
+    }
+}
+
+void FrameScheduler::ensureTicking() {
+    // Idle scheduler: run this frame right away and open a new frame window;
+    // work arriving inside the window waits for the next tick.
+    if (!m_timer->isActive()) {
+        m_timer->start(frameInterval());
+        tick();
+    }
+}
+
+void FrameScheduler::tick() {
+    TRACKPLOT_TRACE_SPAN("frame");
+    ++m_frameCount;
+
+    // (1) One-off tasks first (axis commits), so the views handle their
+    // moves against the ranges of this frame.
+    m_runningTasks.swap(m_tasks);
+    for (const Task &task: m_runningTasks) {
+        if (task.owner) {
+            task.run();
+        }
+    }
+    m_runningTasks.clear();
+
+    // (2) Latest mouse move of every active view, highest priority first.
+    bool busy = !m_tasks.isEmpty();
+    for (ViewEntry &entry: m_views) {
+        // Idle views keep their pending move until their priority is raised
+        if (!entry.active || entry.priority == Priority::Idle) {
+            continue;
+        }
+        ZoomAndScroll *view = entry.view;
+        if (!drawable(view)) {
+            // Hidden, minimized or fully obscured: nothing to draw, drop the move
+            view->m_hasPendingMove = false;
+            entry.active = view->onFrameTick();
+            continue;
+        }
+        if (entry.priority == Priority::Low && m_frameCount % 2 != 0) {
+            busy = true; // Served on the next frame
+            continue;
+        }
+        entry.active = view->onFrameTick();
+        busy = busy || entry.active;
+    }
+
+    // (3) Every request staged above, in one background batch.
+    dispatchTracking();
+
+    if (!busy) {
+        m_timer->stop(); // Nothing left to do, no need to keep ticking
+    }
+}
+
+void FrameScheduler::dispatchTracking() {
+    TRACKPLOT_TRACE_SPAN("dispatchTracking");
+    // One batch in flight at a time; staged requests wait for it (latest wins).
+    if (m_batchInFlight) {
+        return;
+    }
+    m_batchViews.clear(); // Capacity is kept
+    for (const ViewEntry &entry: m_views) {
+        ZoomAndScroll *view = entry.view;
+        if (!view->m_hasPendingBatch) {
+            continue;
+        }
+        view->m_hasPendingBatch = false;
+        // Linked members are staged by the hovered view: skip the ones with
+        // nothing to draw, same as their moves
+        if (entry.priority == Priority::Idle || !drawable(view)) {
+            continue;
+        }
+        view->m_activeBatch = view->m_pendingBatch;
+        // Refresh every series' snapshot on the GUI thread before dispatching.
+        view->prepareBatch();
+        view->m_batchClock.start();
+        m_batchViews.append(view);
+    }
+    if (m_batchViews.isEmpty()) {
+        return;
+    }
+
+    // The worker reads the registered callbacks in place and writes into the
+    // views' preallocated result buffers: no per-batch copies of the data.
+    if (!m_worker) {
+        m_worker = QThread::create([this]() { runWorker(); });
+        m_worker->setObjectName("Tracking worker");
+        m_worker->start();
+    }
+    m_batchInFlight = true;
+    QMutexLocker lock(&m_workerMutex);
+    m_batchQueued = true;
+    m_workerWake.wakeOne();
+}
+
+void FrameScheduler::runWorker() {
+    // Worker thread: runs each queued batch, until the scheduler is destroyed
+    QMutexLocker lock(&m_workerMutex);
+    while (true) {
+        while (!m_batchQueued && !m_stopWorker) {
+            m_workerWake.wait(&m_workerMutex);
+        }
+        if (!m_batchQueued) {
+            return;
+        }
+        lock.unlock();
+        for (ZoomAndScroll *view: std::as_const(m_batchViews)) {
+            view->computeBatch(view->m_activeBatch);
+        }
+        lock.relock();
+        m_batchQueued = false;
+        m_batchDone.wakeAll();
+        QCoreApplication::postEvent(this, new BatchDoneEvent);
+    }
+}
+
+void FrameScheduler::customEvent(QEvent *event) {
+    if (event->type() == BatchDoneEvent::eventType()) {
+        onBatchFinished();
+    }
+}
+
+void FrameScheduler::onBatchFinished() {
+    TRACKPLOT_TRACE_SPAN("batchFinished");
+    m_batchInFlight = false;
+    for (ZoomAndScroll *view: std::as_const(m_batchViews)) {
+        view->finishBatch();
+        // Queueing, worker compute and GUI render of this batch
+        view->m_frameCostNs += view->m_batchClock.nsecsElapsed();
+    }
+    m_batchViews.clear();
+    emit batchFinished();
+    // Requests staged while this batch was running
+    dispatchTracking();
+}
+
+void FrameScheduler::sortViews() {
+    std::stable_sort(m_views.begin(), m_views.end(), [](const ViewEntry &a, const ViewEntry &b) {
+        return a.priority > b.priority;
+    });
+}
@@ -0,0 +1,75 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "latencyStats.h"
+#include <cmath>
+
+void LatencyHistogram::reset() noexcept {
+    for (std::atomic<quint64> &bucket: m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::mean() const noexcept {
+    const quint64 n = count();
+    return n == 0 ? 0 : static_cast<qint64>(m_sum.load(std::memory_order_relaxed) / n);
+}
+
+qint64 LatencyHistogram::percentile(const double p) const noexcept {
+    // Snapshot of the buckets; concurrent records only make it slightly stale
+    std::array<quint64, bucketCount> counts{};
+    quint64 total = 0;
+    for (int i = 0; i < bucketCount; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const auto rank = std::max<quint64>(1, static_cast<quint64>(std::ceil(p * static_cast<double>(total))));
+    quint64 seen = 0;
+    for (int i = 0; i < bucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            // Never above the largest value actually recorded
+            return std::min(static_cast<qint64>(bucketUpperBound(i)), maximum());
+        }
+    }
+    return maximum();
+}
+
+const char *latencyStageName(const LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::InputQueue: return "inputQueue";
+        case LatencyStage::MoveHandling: return "moveHandling";
+        case LatencyStage::Pan: return "pan";
+        case LatencyStage::Wheel: return "wheel";
+        case LatencyStage::BatchQueue: return "batchQueue";
+        case LatencyStage::Compute: return "compute";
+        case LatencyStage::Render: return "render";
+        case LatencyStage::Paint: return "paint";
+        case LatencyStage::EndToEnd: return "endToEnd";
+        case LatencyStage::Count: break;
+    }
+    return "";
+}
@@ -0,0 +1,171 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "segmentKernels.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRACKPLOT_HAS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Squared pixel distance from the cursor to segment i, and its projection.
+    inline qreal segmentDistanceSquared(const qreal *xs, const qreal *ys, const qsizetype i,
+                                        const SegmentQuery &q, qreal &t) {
+        // Cursor at the origin, pixel space
+        const qreal ax = (xs[i] - q.x) * q.scaleX;
+        const qreal ay = (ys[i] - q.y) * q.scaleY;
+        const qreal dx = (xs[i + 1] - xs[i]) * q.scaleX;
+        const qreal dy = (ys[i + 1] - ys[i]) * q.scaleY;
+        const qreal lengthSquared = dx * dx + dy * dy;
+        t = lengthSquared > std::numeric_limits<qreal>::epsilon()
+                ? std::clamp(-(ax * dx + ay * dy) / lengthSquared, 0.0, 1.0)
+                : 0.0;
+        const qreal cx = ax + t * dx;
+        const qreal cy = ay + t * dy;
+        return cx * cx + cy * cy;
+    }
+
+#ifdef TRACKPLOT_HAS_AVX2_KERNEL
+    // Four segments per iteration; keeps the per-lane minimum and its index,
+    // reduced once at the end (ties resolve to the lowest index, as scalar).
+    __attribute__((target("avx2")))
+    NearestSegment nearestSegmentAvx2(const qreal *xs, const qreal *ys, const qsizetype first,
+                                      const qsizetype last, const SegmentQuery &q) {
+        const __m256d qx = _mm256_set1_pd(q.x);
+        const __m256d qy = _mm256_set1_pd(q.y);
+        const __m256d sx = _mm256_set1_pd(q.scaleX);
+        const __m256d sy = _mm256_set1_pd(q.scaleY);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d eps = _mm256_set1_pd(std::numeric_limits<qreal>::epsilon());
+        const __m256d laneOffset = _mm256_set_pd(3, 2, 1, 0);
+
+        __m256d bestDistance = _mm256_set1_pd(std::numeric_limits<qreal>::infinity());
+        __m256d bestIndex = _mm256_set1_pd(-1);
+
+        qsizetype i = first;
+        for (; i + 4 <= last; i += 4) {
+            // Unaligned loads: segment i spans x[i] and x[i + 1]
+            const __m256d x0 = _mm256_loadu_pd(xs + i);
+            const __m256d y0 = _mm256_loadu_pd(ys + i);
+            const __m256d x1 = _mm256_loadu_pd(xs + i + 1);
+            const __m256d y1 = _mm256_loadu_pd(ys + i + 1);
+
+            const __m256d ax = _mm256_mul_pd(_mm256_sub_pd(x0, qx), sx);
+            const __m256d ay = _mm256_mul_pd(_mm256_sub_pd(y0, qy), sy);
+            const __m256d dx = _mm256_mul_pd(_mm256_sub_pd(x1, x0), sx);
+            const __m256d dy = _mm256_mul_pd(_mm256_sub_pd(y1, y0), sy);
+
+            const __m256d lengthSquared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+            const __m256d dot = _mm256_add_pd(_mm256_mul_pd(ax, dx), _mm256_mul_pd(ay, dy));
+            __m256d t = _mm256_div_pd(_mm256_sub_pd(zero, dot), lengthSquared);
+            t = _mm256_min_pd(_mm256_max_pd(t, zero), one);
+            // Degenerate segments: distance to the first end point
+            const __m256d degenerate = _mm256_cmp_pd(lengthSquared, eps, _CMP_LE_OQ);
+            t = _mm256_blendv_pd(t, zero, degenerate);
+
+            const __m256d cx = _mm256_add_pd(ax, _mm256_mul_pd(t, dx));
+            const __m256d cy = _mm256_add_pd(ay, _mm256_mul_pd(t, dy));
+            const __m256d distance = _mm256_add_pd(_mm256_mul_pd(cx, cx), _mm256_mul_pd(cy, cy));
+
+            const __m256d closer = _mm256_cmp_pd(distance, bestDistance, _CMP_LT_OQ);
+            const __m256d index = _mm256_add_pd(_mm256_set1_pd(static_cast<double>(i)), laneOffset);
+            bestDistance = _mm256_blendv_pd(bestDistance, distance, closer);
+            bestIndex = _mm256_blendv_pd(bestIndex, index, closer);
+        }
+
+        alignas(32) double lanesDistance[4];
+        alignas(32) double lanesIndex[4];
+        _mm256_store_pd(lanesDistance, bestDistance);
+        _mm256_store_pd(lanesIndex, bestIndex);
+
+        NearestSegment best;
+        for (int lane = 0; lane < 4; ++lane) {
+            const auto index = static_cast<qsizetype>(lanesIndex[lane]);
+            if (index < 0)
+                continue;
+            if (lanesDistance[lane] < best.distanceSquared ||
+                (lanesDistance[lane] == best.distanceSquared && index < best.index)) {
+                best.distanceSquared = lanesDistance[lane];
+                best.index = index;
+            }
+        }
+
+        // Remaining (< 4) segments
+        for (; i < last; ++i) {
+            qreal t;
+            const qreal distance = segmentDistanceSquared(xs, ys, i, q, t);
+            if (distance < best.distanceSquared) {
+                best.distanceSquared = distance;
+                best.index = i;
+            }
+        }
+        if (best.index >= 0) {
+            segmentDistanceSquared(xs, ys, best.index, q, best.t);
+        }
+        return best;
+    }
+#endif
+
+    using NearestSegmentFn = NearestSegment (*)(const qreal *, const qreal *, qsizetype, qsizetype,
+                                                const SegmentQuery &);
+
+    // Resolved once, on first use
+    NearestSegmentFn selectKernel() {
+#ifdef TRACKPLOT_HAS_AVX2_KERNEL
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return nearestSegmentAvx2;
+        }
+#endif
+        return nearestSegmentScalar;
+    }
+
+    NearestSegmentFn kernel() {
+        static const NearestSegmentFn fn = selectKernel();
+        return fn;
+    }
+}
+
+NearestSegment nearestSegmentScalar(const qreal *xs, const qreal *ys, const qsizetype first,
+                                    const qsizetype last, const SegmentQuery &query) {
+    NearestSegment best;
+    for (qsizetype i = first; i < last; ++i) {
+        qreal t;
+        const qreal distance = segmentDistanceSquared(xs, ys, i, query, t);
+        if (distance < best.distanceSquared) {
+            best.distanceSquared = distance;
+            best.index = i;
+            best.t = t;
+        }
+    }
+    return best;
+}
+
+NearestSegment nearestSegment(const qreal *xs, const qreal *ys, const qsizetype first,
+                              const qsizetype last, const SegmentQuery &query) {
+    return kernel()(xs, ys, first, last, query);
+}
+
+bool segmentKernelVectorized() {
+    return kernel() != nearestSegmentScalar;
+}
@@ -0,0 +1,318 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "seriesExporter.h"
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrent>
+#include <QtEndian>
+#include <charconv>
+#include <cstring>
+
+namespace {
+    constexpr qsizetype chunkSamples = 1 << 16; // Decoded per read
+    constexpr qsizetype flushBytes = 1 << 20; // Buffered per write
+    constexpr char binaryMagic[4] = {'T', 'P', 'E', 'X'};
+    constexpr quint32 binaryVersion = 2; // 2: little-endian on every host
+
+    struct ExportJob {
+        SeriesSnapshot snapshot;
+        qsizetype from = 0;
+        qsizetype to = 0;
+        bool filter = false; // Unsorted x: keep the rows inside the range
+    };
+
+    qsizetype sizeOf(const SeriesSnapshot &s) {
+        if (s.blocks)
+            return s.blocks->size();
+        if (!s.samples.isEmpty())
+            return s.samples.size();
+        return s.points.size();
+    }
+
+    QList<QPointF> read(const SeriesSnapshot &s, const qsizetype from, const qsizetype n) {
+        if (s.blocks)
+            return s.blocks->mid(from, n);
+        if (!s.samples.isEmpty())
+            return s.samples.mid(from, n);
+        return s.points.mid(from, n);
+    }
+
+    // Index range of [xMin, xMax]; compact and block storage are ascending
+    void bound(ExportJob &job, const qreal xMin, const qreal xMax) {
+        const SeriesSnapshot &s = job.snapshot;
+        const qsizetype count = sizeOf(s);
+        if (count == 0) {
+            return;
+        }
+        if (s.blocks || !s.samples.isEmpty()) {
+            auto lower = [&](const qreal x) { return s.blocks ? s.blocks->lowerBound(x) : s.samples.lowerBound(x); };
+            auto xAt = [&](const qsizetype i) { return s.blocks ? s.blocks->at(i).x() : s.samples.x(i); };
+            job.from = lower(xMin);
+            if (xAt(job.from) < xMin) {
+                job.from = count; // Range after the last sample
+            }
+            job.to = std::max(job.from, lower(xMax));
+            if (job.to < count && xAt(job.to) <= xMax) {
+                ++job.to;
+            }
+            return;
+        }
+        const QList<QPointF> &points = s.points;
+        const bool ascending = std::is_sorted(points.cbegin(), points.cend(),
+                                              [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); });
+        if (!ascending) {
+            job.from = 0;
+            job.to = count;
+            job.filter = true;
+            return;
+        }
+        auto byX = [](const QPointF &p, const qreal x) { return p.x() < x; };
+        job.from = std::lower_bound(points.cbegin(), points.cend(), xMin, byX) - points.cbegin();
+        job.to = std::upper_bound(points.cbegin(), points.cend(), xMax,
+                                  [](const qreal x, const QPointF &p) { return x < p.x(); }) - points.cbegin();
+    }
+
+    // Buffered writer over a QSaveFile from a file offset, so the x and y
+    // columns of a series can be filled side by side; fails sticky
+    class ChunkWriter {
+    public:
+        explicit ChunkWriter(QSaveFile &file, const qint64 offset = 0) : m_file(file), m_offset(offset) {
+            m_buffer.reserve(flushBytes + 256);
+        }
+
+        void raw(const void *data, const qsizetype n) {
+            m_buffer.append(static_cast<const char *>(data), n);
+            if (m_buffer.size() >= flushBytes) {
+                flush();
+            }
+        }
+
+        void text(const QByteArray &s) { raw(s.constData(), s.size()); }
+
+        template<typename T>
+        void littleEndian(const T v) {
+            const T le = qToLittleEndian(v);
+            raw(&le, sizeof(le));
+        }
+
+        void number(const qreal v) {
+            std::array<char, 32> digits{};
+            const auto r = std::to_chars(digits.data(), digits.data() + digits.size(), v); // Shortest round-trip
+            raw(digits.data(), r.ptr - digits.data());
+        }
+
+        bool flush() {
+            if (!m_buffer.isEmpty() && m_ok) {
+                m_ok = m_file.seek(m_offset) && m_file.write(m_buffer) == m_buffer.size();
+                m_offset += m_buffer.size();
+            }
+            m_buffer.clear();
+            return m_ok;
+        }
+
+        // Offset after everything written so far, buffered bytes included
+        [[nodiscard]] qint64 end() const { return m_offset + m_buffer.size(); }
+
+        // Continues at another offset
+        void moveTo(const qint64 offset) {
+            flush();
+            m_offset = offset;
+        }
+
+        [[nodiscard]] bool ok() const { return m_ok; }
+
+    private:
+        QSaveFile &m_file;
+        qint64 m_offset;
+        QByteArray m_buffer;
+        bool m_ok = true;
+    };
+
+    QByteArray csvField(const QString &name) {
+        QByteArray field = name.toUtf8();
+        if (field.contains(',') || field.contains('"') || field.contains('\n')) {
+            field.replace("\"", "\"\"");
+            field = '"' + field + '"';
+        }
+        return field;
+    }
+
+    QString writeAll(QPromise<QString> &promise, const QString &path, QList<ExportJob> jobs,
+                     const SeriesExporter::Format format, const bool visible, const qreal xMin, const qreal xMax) {
+        qint64 total = 0;
+        for (ExportJob &job: jobs) {
+            if (visible) {
+                bound(job, xMin, xMax);
+            } else {
+                job.to = sizeOf(job.snapshot);
+            }
+            total += job.to - job.from;
+        }
+        const bool binary = format == SeriesExporter::Format::Binary;
+        qint64 done = 0;
+        auto advance = [&](const qsizetype n) {
+            done += n;
+            promise.setProgressValue(total > 0 ? static_cast<int>(1000 * done / total) : 1000);
+        };
+
+        QSaveFile file(path); // Nothing replaces the target before commit()
+        if (!file.open(QIODevice::WriteOnly)) {
+            return file.errorString();
+        }
+        ChunkWriter out(file);
+
+        // Calls fn(chunk) over the job's rows, in chunks, each decoded once;
+        // false once canceled or fn reports a failed write
+        auto forEachChunk = [&](const ExportJob &job, auto &&fn) {
+            for (qsizetype i = job.from; i < job.to; i += chunkSamples) {
+                if (promise.isCanceled())
+                    return false;
+                const qsizetype n = std::min(chunkSamples, job.to - i);
+                QList<QPointF> chunk = read(job.snapshot, i, n);
+                if (job.filter) {
+                    chunk.removeIf([&](const QPointF &p) { return p.x() < xMin || p.x() > xMax; });
+                }
+                if (!fn(chunk))
+                    return false;
+                advance(n);
+            }
+            return true;
+        };
+
+        if (binary) {
+            out.raw(binaryMagic, sizeof(binaryMagic));
+            out.littleEndian(binaryVersion);
+            out.littleEndian(static_cast<quint32>(jobs.size()));
+        } else {
+            out.text("series,x,y\n");
+        }
+        for (const ExportJob &job: jobs) {
+            if (binary) {
+                // Filtered rows must be counted before the columns are written
+                quint64 rows = job.to - job.from;
+                if (job.filter) {
+                    rows = 0;
+                    for (qsizetype i = job.from; i < job.to; ++i) {
+                        const qreal x = job.snapshot.points[i].x();
+                        rows += x >= xMin && x <= xMax ? 1 : 0;
+                    }
+                }
+                const QByteArray name = job.snapshot.name.toUtf8();
+                out.littleEndian(static_cast<quint32>(name.size()));
+                out.text(name);
+                out.littleEndian(rows);
+                // Both columns fill in one pass, each through its own writer
+                const qint64 columnBytes = static_cast<qint64>(rows * sizeof(qreal));
+                ChunkWriter xOut(file, out.end());
+                ChunkWriter yOut(file, out.end() + columnBytes);
+                out.moveTo(out.end() + 2 * columnBytes);
+                QList<qreal> xs;
+                QList<qreal> ys;
+                const bool complete = forEachChunk(job, [&](const QList<QPointF> &chunk) {
+                    xs.resize(chunk.size());
+                    ys.resize(chunk.size());
+                    for (qsizetype k = 0; k < chunk.size(); ++k) {
+                        xs[k] = qToLittleEndian(chunk[k].x());
+                        ys[k] = qToLittleEndian(chunk[k].y());
+                    }
+                    const qsizetype bytes = chunk.size() * static_cast<qsizetype>(sizeof(qreal));
+                    xOut.raw(xs.constData(), bytes);
+                    yOut.raw(ys.constData(), bytes);
+                    return out.ok() && xOut.ok() && yOut.ok();
+                });
+                if (!xOut.flush() || !yOut.flush()) {
+                    return file.errorString(); // Never committed: the target is untouched
+                }
+                if (!complete)
+                    break;
+            } else {
+                const QByteArray prefix = csvField(job.snapshot.name) + ',';
+                const bool complete = forEachChunk(job, [&](const QList<QPointF> &chunk) {
+                    for (const QPointF &p: chunk) {
+                        out.text(prefix);
+                        out.number(p.x());
+                        out.raw(",", 1);
+                        out.number(p.y());
+                        out.raw("\n", 1);
+                    }
+                    return out.ok();
+                });
+                if (!complete)
+                    break;
+            }
+        }
+
+        if (promise.isCanceled()) {
+            file.cancelWriting();
+            return QStringLiteral("Export canceled");
+        }
+        if (!out.flush() || !file.commit()) {
+            return file.errorString();
+        }
+        return {};
+    }
+}
+
+SeriesExporter::SeriesExporter(ZoomAndScroll *view, QObject *parent)
+    : QObject(parent), m_view(view) {
+    m_watcher = new QFutureWatcher<QString>(this);
+    connect(m_watcher, &QFutureWatcherBase::progressValueChanged, this, &SeriesExporter::progress);
+    connect(m_watcher, &QFutureWatcherBase::finished, this, [this]() {
+        const QFuture<QString> future = m_watcher->future();
+        const QString error = future.isCanceled() || future.resultCount() == 0
+                                  ? QStringLiteral("Export canceled")
+                                  : future.result();
+        emit finished(error.isEmpty(), error);
+    });
+}
+
+SeriesExporter::~SeriesExporter() {
+    // The worker holds the snapshots, not the view; just stop it
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+}
+
+bool SeriesExporter::start(const QString &path, const QList<QXYSeries *> &series, const Format format,
+                           const Range range) {
+    if (isRunning()) {
+        return false;
+    }
+    // Snapshots are O(1) (implicitly shared); everything else runs on the worker
+    QList<ExportJob> jobs;
+    for (const QXYSeries *s: series) {
+        jobs.append({m_view->seriesSnapshot(s)});
+    }
+    const ViewLimits limits = m_view->viewLimits();
+    const bool visible = range == Range::Visible;
+    const auto future = QtConcurrent::run([=](QPromise<QString> &promise) {
+        promise.setProgressRange(0, 1000);
+        promise.addResult(writeAll(promise, path, jobs, format, visible, limits.xMin, limits.xMax));
+    });
+    m_watcher->setFuture(future);
+    return true;
+}
+
+void SeriesExporter::cancel() {
+    m_watcher->cancel();
+}
+
+bool SeriesExporter::isRunning() const {
+    return m_watcher->isRunning();
+}
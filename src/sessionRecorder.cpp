@@ -0,0 +1,432 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "sessionRecorder.h"
+#include "frameScheduler.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QEventLoop>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+    constexpr char magic[4] = {'T', 'P', 'S', 'R'};
+    constexpr qreal positionScale = 256; // Fixed point, 1/256 pixel
+
+    // View flags of the header
+    enum Flag : quint8 {
+        Tracking = 1 << 0,
+        Focus = 1 << 1,
+        Crosshair = 1 << 2,
+        HorizontalZoom = 1 << 3,
+        VerticalZoom = 1 << 4
+    };
+
+    void writePos(QDataStream &out, const QPointF &pos) {
+        out << static_cast<qint32>(std::lround(pos.x() * positionScale))
+            << static_cast<qint32>(std::lround(pos.y() * positionScale));
+    }
+
+    QPointF readPos(QDataStream &in) {
+        qint32 x = 0;
+        qint32 y = 0;
+        in >> x >> y;
+        return {x / positionScale, y / positionScale};
+    }
+
+    void writeLimits(QDataStream &out, const ViewLimits &limits) {
+        out << limits.xMin << limits.xMax << limits.yMin << limits.yMax;
+    }
+
+    ViewLimits readLimits(QDataStream &in) {
+        ViewLimits limits;
+        in >> limits.xMin >> limits.xMax >> limits.yMin >> limits.yMax;
+        return limits;
+    }
+
+    bool sameView(const ViewLimits &a, const ViewLimits &b) {
+        const qreal tx = 1e-9 * std::max(std::abs(a.xMax - a.xMin), std::abs(b.xMax - b.xMin));
+        const qreal ty = 1e-9 * std::max(std::abs(a.yMax - a.yMin), std::abs(b.yMax - b.yMin));
+        return std::abs(a.xMin - b.xMin) <= tx && std::abs(a.xMax - b.xMax) <= tx &&
+               std::abs(a.yMin - b.yMin) <= ty && std::abs(a.yMax - b.yMax) <= ty;
+    }
+
+    double percentile(const std::vector<double> &sorted, const double p) {
+        const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+SessionRecorder::SessionRecorder(ZoomAndScroll *view, QObject *parent)
+    : QObject(parent)
+      , m_view(view) {
+}
+
+SessionRecorder::~SessionRecorder() {
+    stop();
+}
+
+bool SessionRecorder::start(const QString &path) {
+    stop();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    m_stream = new QDataStream(&m_file);
+    m_stream->setVersion(QDataStream::Qt_6_0);
+
+    quint8 flags = 0;
+    flags |= m_view->toggleState ? Tracking : 0;
+    flags |= m_view->toggleFocus ? Focus : 0;
+    flags |= m_view->toggleLines ? Crosshair : 0;
+    flags |= m_view->resizeHorZoom ? HorizontalZoom : 0;
+    flags |= m_view->resizeVerZoom ? VerticalZoom : 0;
+    m_stream->writeRawData(magic, sizeof(magic));
+    *m_stream << formatVersion << static_cast<qint32>(m_view->viewport()->width())
+            << static_cast<qint32>(m_view->viewport()->height());
+    writeLimits(*m_stream, m_view->viewLimits());
+    *m_stream << flags;
+
+    // Keys reach the view, pointer events and resizes its viewport
+    m_view->installEventFilter(this);
+    m_view->viewport()->installEventFilter(this);
+    m_viewConnection = connect(m_view, &ZoomAndScroll::viewChanged, this, [this](const ViewLimits &limits) {
+        SessionRecord record;
+        record.kind = SessionRecord::Kind::View;
+        record.limits = limits;
+        write(record);
+    });
+    m_lastUs = 0;
+    m_clock.start();
+    return true;
+}
+
+void SessionRecorder::stop() {
+    if (!m_file.isOpen()) {
+        return;
+    }
+    m_view->removeEventFilter(this);
+    m_view->viewport()->removeEventFilter(this);
+    disconnect(m_viewConnection);
+    delete m_stream;
+    m_stream = nullptr;
+    m_file.close();
+}
+
+bool SessionRecorder::eventFilter(QObject *watched, QEvent *event) {
+    SessionRecord record;
+    record.type = static_cast<quint16>(event->type());
+    switch (event->type()) {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::MouseButtonDblClick:
+        case QEvent::MouseMove: {
+            if (watched != m_view->viewport())
+                break;
+            const auto *mouse = static_cast<QMouseEvent *>(event);
+            record.kind = SessionRecord::Kind::Mouse;
+            record.pos = mouse->position();
+            record.button = mouse->button();
+            record.buttons = mouse->buttons();
+            record.modifiers = mouse->modifiers();
+            write(record);
+            break;
+        }
+        case QEvent::Wheel: {
+            if (watched != m_view->viewport())
+                break;
+            const auto *wheel = static_cast<QWheelEvent *>(event);
+            record.kind = SessionRecord::Kind::Wheel;
+            record.pos = wheel->position();
+            record.button = static_cast<quint32>(wheel->angleDelta().y());
+            record.buttons = wheel->buttons();
+            record.modifiers = wheel->modifiers();
+            write(record);
+            break;
+        }
+        case QEvent::KeyPress: {
+            if (watched != m_view)
+                break;
+            const auto *key = static_cast<QKeyEvent *>(event);
+            record.kind = SessionRecord::Kind::Key;
+            record.button = static_cast<quint32>(key->key());
+            record.modifiers = key->modifiers();
+            write(record);
+            break;
+        }
+        case QEvent::Resize: {
+            if (watched != m_view->viewport())
+                break;
+            record.kind = SessionRecord::Kind::Resize;
+            record.size = static_cast<QResizeEvent *>(event)->size();
+            write(record);
+            break;
+        }
+        default:
+            break;
+    }
+    return false; // Observe only
+}
+
+void SessionRecorder::write(SessionRecord record) {
+    const qint64 now = m_clock.nsecsElapsed() / 1000;
+    QDataStream &out = *m_stream;
+    out << static_cast<quint8>(record.kind) << static_cast<quint32>(std::min<qint64>(now - m_lastUs, std::numeric_limits<quint32>::max()));
+    m_lastUs = now;
+    switch (record.kind) {
+        case SessionRecord::Kind::Mouse:
+            out << record.type;
+            writePos(out, record.pos);
+            out << record.button << record.buttons << record.modifiers;
+            break;
+        case SessionRecord::Kind::Wheel:
+            writePos(out, record.pos);
+            out << record.button << record.buttons << record.modifiers;
+            break;
+        case SessionRecord::Kind::Key:
+            out << record.button << record.modifiers;
+            break;
+        case SessionRecord::Kind::Resize:
+            out << static_cast<qint32>(record.size.width()) << static_cast<qint32>(record.size.height());
+            break;
+        case SessionRecord::Kind::View:
+            writeLimits(out, record.limits);
+            break;
+    }
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+SessionReplayer::SessionReplayer(QObject *parent)
+    : QObject(parent) {
+}
+
+SessionReplayer::~SessionReplayer() = default;
+
+bool SessionReplayer::load(const QString &path) {
+    m_records.clear();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_error = file.errorString();
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    char header[sizeof(magic)] = {};
+    quint32 version = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+    in.readRawData(header, sizeof(header));
+    in >> version >> width >> height;
+    m_limits = readLimits(in);
+    in >> m_flags;
+    if (in.status() != QDataStream::Ok || !std::equal(header, header + sizeof(header), magic) ||
+        version != SessionRecorder::formatVersion) {
+        m_error = QStringLiteral("not a session file of version %1").arg(SessionRecorder::formatVersion);
+        return false;
+    }
+    m_viewportSize = QSize(width, height);
+
+    qint64 timeUs = 0;
+    while (!in.atEnd()) {
+        SessionRecord record;
+        quint8 kind = 0;
+        quint32 deltaUs = 0;
+        in >> kind >> deltaUs;
+        timeUs += deltaUs;
+        record.kind = static_cast<SessionRecord::Kind>(kind);
+        record.timeUs = timeUs;
+        switch (record.kind) {
+            case SessionRecord::Kind::Mouse:
+                in >> record.type;
+                record.pos = readPos(in);
+                in >> record.button >> record.buttons >> record.modifiers;
+                break;
+            case SessionRecord::Kind::Wheel:
+                record.pos = readPos(in);
+                in >> record.button >> record.buttons >> record.modifiers;
+                break;
+            case SessionRecord::Kind::Key:
+                in >> record.button >> record.modifiers;
+                break;
+            case SessionRecord::Kind::Resize: {
+                qint32 w = 0;
+                qint32 h = 0;
+                in >> w >> h;
+                record.size = QSize(w, h);
+                break;
+            }
+            case SessionRecord::Kind::View:
+                record.limits = readLimits(in);
+                break;
+            default:
+                in.setStatus(QDataStream::ReadCorruptData);
+                break;
+        }
+        if (in.status() != QDataStream::Ok) {
+            break; // Truncated tail (e.g. recording interrupted): keep what was read
+        }
+        m_records.append(record);
+    }
+    m_error.clear();
+    return true;
+}
+
+SessionReplayer::Stats SessionReplayer::replay(ZoomAndScroll *view, const Pacing pacing) {
+    FrameScheduler *scheduler = FrameScheduler::instance();
+    // An Idle view gets no frames, so its moves would never be handled and
+    // the waits below would never return: replay it at Normal priority.
+    const FrameScheduler::Priority priority = scheduler->priority(view);
+    if (priority == FrameScheduler::Priority::Idle) {
+        scheduler->setPriority(view, FrameScheduler::Priority::Normal);
+    }
+    const auto waitForIdle = [view, scheduler]() {
+        // The frame after the last handled move finds nothing and goes idle
+        while (view->m_frameActive) {
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        }
+        scheduler->waitForBatch();
+        QCoreApplication::processEvents();
+    };
+
+    // Recorded starting state
+    if (view->isWindow()) {
+        view->resize(view->size() - view->viewport()->size() + m_viewportSize);
+    }
+    waitForIdle();
+    view->toggleState = m_flags & Tracking;
+    view->toggleFocus = m_flags & Focus;
+    view->toggleLines = m_flags & Crosshair;
+    view->resizeHorZoom = m_flags & HorizontalZoom;
+    view->resizeVerZoom = m_flags & VerticalZoom;
+    view->hideTrackers();
+    view->applyLimits(m_limits);
+    view->clearHistory();
+    QCoreApplication::processEvents();
+
+    Stats stats;
+    std::vector<double> latencies;
+    latencies.reserve(m_records.size());
+    const quint64 droppedBefore = view->droppedMoveEvents();
+    QSize recordedSize = m_viewportSize;
+    QElapsedTimer clock;
+    clock.start();
+    const bool deterministic = pacing == Pacing::Deterministic;
+    for (qsizetype i = 0; i < m_records.size(); ++i) {
+        const SessionRecord &record = m_records[i];
+        if (record.kind == SessionRecord::Kind::Resize) {
+            recordedSize = record.size;
+            continue;
+        }
+        if (record.kind == SessionRecord::Kind::View) {
+            // Recorded after the events before it were handled: compare now.
+            // Live coalescing is not reproduced exactly, so real time skips it.
+            if (deterministic) {
+                waitForIdle();
+                ++stats.viewChecks;
+                if (!sameView(view->viewLimits(), record.limits)) {
+                    ++stats.viewMismatches;
+                }
+            }
+            continue;
+        }
+
+        // When the next input event is due (real time)
+        qint64 nextUs = std::numeric_limits<qint64>::max();
+        for (qsizetype j = i + 1; j < m_records.size(); ++j) {
+            if (m_records[j].kind != SessionRecord::Kind::View && m_records[j].kind != SessionRecord::Kind::Resize) {
+                nextUs = m_records[j].timeUs;
+                break;
+            }
+        }
+        if (deterministic) {
+            waitForIdle();
+        } else {
+            while (clock.nsecsElapsed() / 1000 < record.timeUs) {
+                QCoreApplication::processEvents();
+            }
+        }
+
+        const QSize size = view->viewport()->size();
+        const QPointF pos(record.pos.x() * size.width() / std::max(1, recordedSize.width()),
+                          record.pos.y() * size.height() / std::max(1, recordedSize.height()));
+        const auto modifiers = Qt::KeyboardModifiers::fromInt(static_cast<int>(record.modifiers));
+        const auto buttons = Qt::MouseButtons::fromInt(static_cast<int>(record.buttons));
+        QElapsedTimer eventClock;
+        eventClock.start();
+        if (record.kind == SessionRecord::Kind::Mouse) {
+            QMouseEvent event(static_cast<QEvent::Type>(record.type), pos, view->viewport()->mapToGlobal(pos),
+                              static_cast<Qt::MouseButton>(record.button), buttons, modifiers);
+            QCoreApplication::sendEvent(view->viewport(), &event);
+        } else if (record.kind == SessionRecord::Kind::Wheel) {
+            QWheelEvent event(pos, view->viewport()->mapToGlobal(pos), QPoint(),
+                              QPoint(0, static_cast<qint32>(record.button)), buttons, modifiers,
+                              Qt::NoScrollPhase, false);
+            QCoreApplication::sendEvent(view->viewport(), &event);
+        } else {
+            QKeyEvent event(QEvent::KeyPress, static_cast<int>(record.button), modifiers);
+            QCoreApplication::sendEvent(view, &event);
+        }
+
+        // Handled once its frame has run and the tracking batch is rendered.
+        // In real time, a move still waiting when the next event is due is
+        // left to coalesce with it (not timed).
+        while (view->m_hasPendingMove) {
+            if (deterministic) {
+                QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+            } else if (clock.nsecsElapsed() / 1000 < nextUs) {
+                QCoreApplication::processEvents();
+            } else {
+                break;
+            }
+        }
+        if (!view->m_hasPendingMove) {
+            scheduler->waitForBatch();
+            QCoreApplication::processEvents(); // Batch results
+            QCoreApplication::processEvents(); // Repaint they requested
+            latencies.push_back(static_cast<double>(eventClock.nsecsElapsed()) / 1e6);
+        }
+        ++stats.events;
+    }
+    waitForIdle();
+    scheduler->setPriority(view, priority);
+
+    stats.droppedMoves = view->droppedMoveEvents() - droppedBefore;
+    if (!latencies.empty()) {
+        for (const double ms: latencies) {
+            stats.totalMs += ms;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        stats.p50Ms = percentile(latencies, 0.50);
+        stats.p90Ms = percentile(latencies, 0.90);
+        stats.p99Ms = percentile(latencies, 0.99);
+        stats.maxMs = latencies.back();
+    }
+    return stats;
+}
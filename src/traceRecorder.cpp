@@ -0,0 +1,194 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "traceRecorder.h"
+#include <QCoreApplication>
+#include <QHash>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace {
+    // Small sequential thread ids, named on first use
+    QMutex threadNamesMutex;
+    QHash<int, QString> threadNames;
+    std::atomic<int> nextThread{1};
+
+    int currentThread() {
+        thread_local int id = 0;
+        if (id == 0) {
+            id = nextThread.fetch_add(1, std::memory_order_relaxed);
+            const QThread *thread = QThread::currentThread();
+            QString name = thread->objectName();
+            if (name.isEmpty()) {
+                name = QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()
+                           ? QStringLiteral("GUI")
+                           : QStringLiteral("Worker %1").arg(id);
+            }
+            const QMutexLocker lock(&threadNamesMutex);
+            threadNames.insert(id, name);
+        }
+        return id;
+    }
+
+    struct Span {
+        const char *name;
+        qint64 begin;
+        qint64 end;
+        qint64 arg;
+        int thread;
+    };
+}
+
+TraceRecorder &TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() {
+    setCapacity(defaultCapacity);
+}
+
+void TraceRecorder::setEnabled(const bool enabled) {
+    s_enabled.store(enabled); // Sequentially consistent: see record()
+}
+
+bool TraceRecorder::pause() {
+    const bool wasEnabled = s_enabled.exchange(false);
+    while (m_writers.load() != 0) {
+        QThread::yieldCurrentThread(); // A span's worth of stores at most
+    }
+    return wasEnabled;
+}
+
+void TraceRecorder::setCapacity(const qsizetype events) {
+    const bool wasEnabled = pause();
+    const auto size = std::bit_ceil(static_cast<quint64>(std::max<qsizetype>(2, events)));
+    m_slots = std::make_unique<Slot[]>(size);
+    m_mask = static_cast<qsizetype>(size - 1);
+    m_next.store(0, std::memory_order_relaxed);
+    setEnabled(wasEnabled);
+}
+
+void TraceRecorder::clear() {
+    const bool wasEnabled = pause();
+    for (qsizetype i = 0; i <= m_mask; ++i) {
+        m_slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    m_next.store(0, std::memory_order_relaxed);
+    setEnabled(wasEnabled);
+}
+
+void TraceRecorder::record(const char *name, const qint64 beginNs, const qint64 endNs, const qint64 arg) noexcept {
+    // Registered as a writer before checking the flag (both sequentially
+    // consistent): pause() either sees this writer or this writer sees it off.
+    m_writers.fetch_add(1);
+    if (!s_enabled.load()) {
+        m_writers.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+    const int thread = currentThread();
+    const quint64 ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = m_slots[static_cast<qsizetype>(ticket) & m_mask];
+    // Seqlock write: readers skip the slot while it is being rewritten
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(beginNs, std::memory_order_relaxed);
+    slot.end.store(endNs, std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+    slot.thread.store(thread, std::memory_order_relaxed);
+    slot.sequence.store(ticket + 1, std::memory_order_release);
+    m_writers.fetch_sub(1, std::memory_order_release);
+}
+
+QByteArray TraceRecorder::toJson() const {
+    // Consistent copies of the slots still holding their ticket
+    const quint64 next = m_next.load(std::memory_order_acquire);
+    const quint64 capacity = static_cast<quint64>(m_mask) + 1;
+    const quint64 first = next > capacity ? next - capacity : 0;
+    std::vector<Span> spans;
+    spans.reserve(next - first);
+    for (quint64 ticket = first; ticket < next; ++ticket) {
+        const Slot &slot = m_slots[static_cast<qsizetype>(ticket) & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != ticket + 1) {
+            continue; // Being written, or already overwritten
+        }
+        const Span span{
+            slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+            slot.end.load(std::memory_order_relaxed), slot.arg.load(std::memory_order_relaxed),
+            slot.thread.load(std::memory_order_relaxed)
+        };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == ticket + 1) {
+            spans.push_back(span);
+        }
+    }
+    std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) { return a.begin < b.begin; });
+
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    const qint64 origin = spans.empty() ? 0 : spans.front().begin;
+    QByteArray json;
+    json.reserve(static_cast<qsizetype>(spans.size()) * 96 + 256);
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool firstEvent = true;
+    const auto separator = [&]() {
+        if (!firstEvent) {
+            json.append(",\n");
+        }
+        firstEvent = false;
+    };
+    {
+        const QMutexLocker lock(&threadNamesMutex);
+        for (const int thread: threadNames.keys()) {
+            separator();
+            json.append("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" +
+                        QByteArray::number(thread) + ",\"args\":{\"name\":\"" +
+                        threadNames.value(thread).toUtf8() + "\"}}");
+        }
+    }
+    for (const Span &span: spans) {
+        // Complete events, microseconds from the first span
+        separator();
+        json.append("{\"ph\":\"X\",\"name\":\"");
+        json.append(span.name);
+        json.append("\",\"pid\":" + pid + ",\"tid\":" + QByteArray::number(span.thread) + ",\"ts\":" +
+                    QByteArray::number(static_cast<double>(span.begin - origin) / 1e3, 'f', 3) + ",\"dur\":" +
+                    QByteArray::number(static_cast<double>(span.end - span.begin) / 1e3, 'f', 3));
+        if (span.arg >= 0) {
+            json.append(",\"args\":{\"slot\":" + QByteArray::number(span.arg) + "}");
+        }
+        json.append('}');
+    }
+    json.append("]}\n");
+    return json;
+}
+
+bool TraceRecorder::dump(const QString &path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const QByteArray json = toJson();
+    return file.write(json) == json.size() && file.commit();
+}
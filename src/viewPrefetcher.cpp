@@ -0,0 +1,357 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "viewPrefetcher.h"
+#include "datasetIndex.h"
+#include "trackKernels.h"
+#include <QXYSeries>
+#include <QtConcurrent/QtConcurrent>
+#include <cmath>
+
+namespace {
+    // Below this many samples per pixel column the raw points are drawn as they are
+    constexpr qreal rawPointsPerColumn = 4;
+    // Pan look-ahead, in view changes, and its cap in tiles per side
+    constexpr qreal panSteps = 2;
+    constexpr qint64 maxTilesPerSide = 8;
+    constexpr int overviewColumns = 2048;
+
+    DecimationTile decimate(const QList<QPointF> &points, const CompactSamples &samples, const bool compact,
+                            const DecimationGrid &grid, const int level, const qint64 index) {
+        if (compact) {
+            return decimateTile(samples, grid, level, index);
+        }
+        return decimateTile(points.constData(), points.size(), grid, level, index);
+    }
+
+    // Sum of y over points [from, to): whole level-0 buckets from the index's
+    // prefix sums, only the partial buckets at both edges from the points.
+    qreal indexedSum(const DatasetIndex &index, const QList<QPointF> &points, const qsizetype from,
+                     const qsizetype to) {
+        const auto rawSum = [&points](const qsizetype first, const qsizetype last) {
+            qreal sum = 0;
+            for (qsizetype i = first; i < last; ++i) {
+                sum += points[i].y();
+            }
+            return sum;
+        };
+        constexpr qint64 bucket = DatasetIndex::baseBucketSamples;
+        const qint64 firstBucket = (from + bucket - 1) / bucket;
+        const qint64 lastBucket = to / bucket;
+        if (firstBucket >= lastBucket) {
+            return rawSum(from, to);
+        }
+        return rawSum(from, firstBucket * bucket) + index.bucketSum(firstBucket, lastBucket) +
+               rawSum(lastBucket * bucket, to);
+    }
+}
+
+QList<QPointF> ViewPrefetcher::Source::mid(const qsizetype from, const qsizetype n) const {
+    return compact ? samples.mid(from, n) : points.mid(from, n);
+}
+
+qsizetype ViewPrefetcher::Source::lowerBound(const qreal x) const {
+    return compact ? samples.lowerBound(x) : lowerBoundX<true>(points.constData(), 0, points.size() - 1, x);
+}
+
+ViewPrefetcher::ViewPrefetcher(QObject *parent)
+    : QObject(parent) {
+    m_watcher = new QFutureWatcher<void>(this);
+    connect(m_watcher, &QFutureWatcher<void>::finished, this, [this]() { onPrefetchFinished(); });
+}
+
+ViewPrefetcher::~ViewPrefetcher() {
+    // The worker writes into m_jobs
+    m_watcher->waitForFinished();
+}
+
+void ViewPrefetcher::setSource(const int slot, QXYSeries *series, const QList<QPointF> &points,
+                               const DatasetIndex *index) {
+    if (slot >= m_sources.size()) {
+        m_sources.resize(slot + 1);
+    }
+    Source &source = m_sources[slot];
+    source.series = series;
+    source.points = points;
+    source.samples = {};
+    source.compact = false;
+    source.index = index && index->isValid() && index->count() == points.size() ? index : nullptr;
+    // Tiles rely on binary searches: unsorted data is drawn as it is
+    source.grid = source.index && !source.index->ascending() ? DecimationGrid{} : DecimationGrid::forPoints(points);
+    attach(slot, source);
+}
+
+void ViewPrefetcher::setSource(const int slot, QXYSeries *series, const CompactSamples &samples) {
+    if (slot >= m_sources.size()) {
+        m_sources.resize(slot + 1);
+    }
+    Source &source = m_sources[slot];
+    source.series = series;
+    source.points = {};
+    source.samples = samples;
+    source.compact = true;
+    source.index = nullptr;
+    source.grid = DecimationGrid::forSamples(samples);
+    attach(slot, source);
+}
+
+void ViewPrefetcher::removeSource(const int slot) {
+    if (slot >= 0 && slot < m_sources.size()) {
+        m_sources[slot] = {}; // Its in-flight tiles no longer match a generation
+    }
+}
+
+void ViewPrefetcher::attach(const int slot, Source &source) {
+    source.generation = ++m_nextGeneration; // Older tiles are never looked up again (LRU drops them)
+    source.stats = {};
+    if (m_hasView || !source.grid.isValid()) {
+        display(slot, source);
+        return;
+    }
+    // Not laid out yet: whole-series overview (same as decimateOverview())
+    const qsizetype count = source.size();
+    if (source.index) {
+        const QRectF bounds = source.index->bounds();
+        source.series->replace(source.index->overview(bounds.left(), bounds.right(), overviewColumns));
+        return;
+    }
+    if (count <= 4 * overviewColumns) {
+        source.series->replace(source.mid(0, count));
+        return;
+    }
+    const qreal span = source.at(count - 1).x() - source.grid.x0;
+    const int level = source.grid.levelFor(span / overviewColumns);
+    QList<QPointF> overview;
+    const qint64 lastTile = source.grid.tileAt(level, source.at(count - 1).x());
+    for (qint64 t = 0; t <= lastTile; ++t) {
+        overview.append(decimate(source.points, source.samples, source.compact, source.grid, level, t).points);
+    }
+    source.series->replace(overview);
+}
+
+void ViewPrefetcher::viewChanged(const qreal xMin, const qreal xMax, const qreal plotWidth) {
+    if (m_sources.isEmpty() || xMax <= xMin)
+        return;
+    if (m_hasView && qFuzzyCompare(xMin, m_xMin) && qFuzzyCompare(xMax, m_xMax) &&
+        qFuzzyCompare(plotWidth, m_plotWidth))
+        return;
+
+    if (m_hasView) {
+        m_velocity = (xMin + xMax) / 2 - (m_xMin + m_xMax) / 2;
+        m_zoomRatio = (xMax - xMin) / (m_xMax - m_xMin);
+    }
+    m_xMin = xMin;
+    m_xMax = xMax;
+    m_plotWidth = std::max<qreal>(1, plotWidth);
+    m_hasView = true;
+
+    for (int slot = 0; slot < m_sources.size(); ++slot) {
+        if (m_sources[slot].series) {
+            display(slot, m_sources[slot]);
+        }
+    }
+    predict();
+}
+
+void ViewPrefetcher::setCoarseLevels(const int levels) {
+    const int coarse = std::max(0, levels);
+    if (coarse == m_coarseLevels)
+        return;
+    m_coarseLevels = coarse;
+    if (!m_hasView)
+        return;
+    for (int slot = 0; slot < m_sources.size(); ++slot) {
+        if (m_sources[slot].series) {
+            display(slot, m_sources[slot]);
+        }
+    }
+}
+
+int ViewPrefetcher::levelFor(const Source &source, const qreal columnWidth) const {
+    return source.grid.levelFor(columnWidth) + m_coarseLevels;
+}
+
+void ViewPrefetcher::setMemoryBudget(const qsizetype bytes) {
+    m_tiles.setMaxCost(std::max<qsizetype>(0, bytes / 1024)); // Evicts LRU tiles
+}
+
+qsizetype ViewPrefetcher::memoryBudget() const {
+    return m_tiles.maxCost() * 1024;
+}
+
+void ViewPrefetcher::resetCounters() {
+    m_hits = 0;
+    m_misses = 0;
+}
+
+VisibleStats ViewPrefetcher::visibleStats(const int slot) const {
+    return slot >= 0 && slot < m_sources.size() ? m_sources[slot].stats : VisibleStats{};
+}
+
+void ViewPrefetcher::display(const int slot, Source &source) {
+    if (!source.grid.isValid()) {
+        source.series->replace(source.mid(0, source.size()));
+        return;
+    }
+    const qsizetype count = source.size();
+    const qsizetype first = source.lowerBound(m_xMin);
+    const qsizetype last = source.lowerBound(m_xMax);
+
+    // Few samples in view: draw them as they are (plus one on each side)
+    const qreal columnWidth = (m_xMax - m_xMin) / m_plotWidth;
+    if (static_cast<qreal>(last - first) <= rawPointsPerColumn * m_plotWidth) {
+        const qsizetype from = std::max<qsizetype>(0, first - 1);
+        const qsizetype to = std::min(count, last + 1);
+        const QList<QPointF> raw = source.mid(from, to - from);
+        source.series->replace(raw);
+        source.stats = {};
+        for (const QPointF &p: raw) {
+            source.stats.merge({1, p.y(), p.y(), p.y()});
+        }
+        return;
+    }
+
+    const int level = levelFor(source, columnWidth);
+    const qint64 firstTile = std::max<qint64>(0, source.grid.tileAt(level, m_xMin));
+    const qint64 lastTile = source.grid.tileAt(level, std::min(m_xMax, source.at(count - 1).x()));
+
+    QList<QPointF> view;
+    view.reserve((lastTile - firstTile + 1) * 2 * DecimationGrid::tileColumns + 2);
+    source.stats = {};
+    if (first > 0) {
+        view.append(source.at(first - 1)); // Line enters the plot from the left edge
+    }
+    for (qint64 t = firstTile; t <= lastTile; ++t) {
+        if (const DecimationTile *decimated = tile(slot, source, level, t)) {
+            view.append(decimated->points);
+            source.stats.merge(decimated->stats);
+        }
+    }
+    if (last < count - 1) {
+        view.append(source.at(last + 1));
+    }
+    source.series->replace(view);
+
+    if (source.index) {
+        // The tiles extend past the view edges: count and sum the visible
+        // samples exactly, in O(bucket) instead of O(visible samples)
+        const qsizetype to = last + (source.at(last).x() <= m_xMax ? 1 : 0);
+        source.stats.count = std::max<qsizetype>(0, to - first);
+        source.stats.sum = indexedSum(*source.index, source.points, first, std::max(first, to));
+    }
+}
+
+const DecimationTile *ViewPrefetcher::tile(const int slot, const Source &source, const int level,
+                                           const qint64 index) {
+    const TileKey key{slot, source.generation, level, index};
+    if (const DecimationTile *cached = m_tiles.object(key)) {
+        ++m_hits;
+        return cached;
+    }
+    ++m_misses;
+    insertTile(key, decimate(source.points, source.samples, source.compact, source.grid, level, index));
+    return m_tiles.object(key); // nullptr if a single tile is over the budget
+}
+
+void ViewPrefetcher::predict() {
+    QList<TileJob> jobs;
+    const qreal span = m_xMax - m_xMin;
+    const qreal columnWidth = span / m_plotWidth;
+    for (int slot = 0; slot < m_sources.size(); ++slot) {
+        const Source &source = m_sources[slot];
+        if (!source.series || !source.grid.isValid())
+            continue;
+        const int level = levelFor(source, columnWidth);
+
+        if (m_zoomRatio < 0.99 || m_zoomRatio > 1.01) {
+            // Zooming: the next view is expected one more step in the same direction
+            const qreal nextSpan = span * m_zoomRatio;
+            const qreal center = (m_xMin + m_xMax) / 2 + m_velocity;
+            const int nextLevel = levelFor(source, nextSpan / m_plotWidth);
+            queueTiles(slot, source, nextLevel, center - nextSpan / 2, center + nextSpan / 2, jobs);
+        } else if (!qFuzzyIsNull(m_velocity)) {
+            // Panning: the stretch the next views uncover, in the direction of motion
+            const qreal ahead = std::min(std::abs(m_velocity) * panSteps,
+                                         source.grid.tileWidth(level) * maxTilesPerSide);
+            if (m_velocity > 0) {
+                queueTiles(slot, source, level, m_xMax, m_xMax + ahead, jobs);
+            } else {
+                queueTiles(slot, source, level, m_xMin - ahead, m_xMin, jobs);
+            }
+        } else {
+            // At rest: one tile on each side
+            const qreal tileWidth = source.grid.tileWidth(level);
+            queueTiles(slot, source, level, m_xMin - tileWidth, m_xMin, jobs);
+            queueTiles(slot, source, level, m_xMax, m_xMax + tileWidth, jobs);
+        }
+    }
+    if (jobs.isEmpty())
+        return;
+    if (m_watcher->isRunning()) {
+        m_pendingJobs = std::move(jobs);
+        m_hasPendingJobs = true;
+        return;
+    }
+    dispatch(std::move(jobs));
+}
+
+void ViewPrefetcher::queueTiles(const int slot, const Source &source, const int level, const qreal from,
+                                const qreal to, QList<TileJob> &jobs) const {
+    const qint64 lastTile = source.grid.tileAt(level, source.at(source.size() - 1).x());
+    const qint64 first = std::max<qint64>(0, source.grid.tileAt(level, from));
+    const qint64 last = std::min(lastTile, source.grid.tileAt(level, to));
+    for (qint64 t = first; t <= last && t - first < maxTilesPerSide * 2; ++t) {
+        const TileKey key{slot, source.generation, level, t};
+        if (!m_tiles.contains(key)) { // Does not count as a use
+            jobs.append({key, source.points, source.samples, source.compact, source.grid, {}});
+        }
+    }
+}
+
+void ViewPrefetcher::dispatch(QList<TileJob> jobs) {
+    m_jobs = std::move(jobs);
+    // The worker only reads the jobs' shared (immutable) samples and
+    // writes each job's result; the cache is only touched on the GUI thread.
+    const auto future = QtConcurrent::run([this]() {
+        for (TileJob &job: m_jobs) {
+            job.result = decimate(job.points, job.samples, job.compact, job.grid, job.key.level, job.key.index);
+        }
+    });
+    m_watcher->setFuture(future);
+}
+
+void ViewPrefetcher::onPrefetchFinished() {
+    for (TileJob &job: m_jobs) {
+        // Sources replaced meanwhile have a new generation: stale tiles are dropped
+        if (m_sources[job.key.slot].generation == job.key.generation && !m_tiles.contains(job.key)) {
+            insertTile(job.key, std::move(job.result));
+        }
+    }
+    m_jobs.clear();
+    if (m_hasPendingJobs) {
+        m_hasPendingJobs = false;
+        dispatch(std::move(m_pendingJobs));
+    }
+}
+
+void ViewPrefetcher::insertTile(const TileKey &key, DecimationTile tile) {
+    const qsizetype cost = std::max<qsizetype>(1, tile.bytes() / 1024);
+    m_tiles.insert(key, new DecimationTile(std::move(tile)), cost);
+}
@@ -0,0 +1,247 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Heap allocations of steady-state tracking frames. The malloc family is
+// hooked (glibc), so Qt's QArrayData buffers are counted along with operator
+// new, on every thread. Each counted frame runs from the move reaching the
+// view (the copy QApplication makes of it on the way is not part of the
+// tracking path) until every series rendered the batch: frame tick, move
+// handling, batch dispatch, worker compute and render.
+// A cursor held on one pixel only costs the posted batch-completion event.
+// A moving cursor also updates the labels and lines every frame, where Qt
+// allocates (QLabel::setText relayout, scene and widget update requests):
+// that path is held to a fixed per-frame budget, independent of the data
+// size, rather than to zero.
+
+#include "customEvents.h"
+#include "frameScheduler.h"
+#include <QApplication>
+#include <QDeadlineTimer>
+#include <QMouseEvent>
+#include <QTest>
+#include <QValueAxis>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+    std::atomic<bool> counting{false};
+    std::atomic<quint64> allocations{0};
+
+    void countAllocation() {
+        if (counting.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+
+void *malloc(const size_t size) noexcept {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(const size_t count, const size_t size) noexcept {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, const size_t size) noexcept {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+int posix_memalign(void **pointer, const size_t alignment, const size_t size) noexcept {
+    countAllocation();
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer ? 0 : ENOMEM;
+}
+
+void *aligned_alloc(const size_t alignment, const size_t size) noexcept {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+}
+#endif
+
+namespace {
+    // Opens the counting window once Qt has delivered a move to the view.
+    class MoveWindow final : public QObject {
+    public:
+        bool armed = false;
+
+    protected:
+        bool eventFilter(QObject *, QEvent *event) override {
+            if (armed && event->type() == QEvent::MouseMove) {
+                counting.store(true, std::memory_order_relaxed);
+            }
+            return false;
+        }
+    };
+
+    QList<QPointF> makeSeries(const qsizetype count, const int index) {
+        QList<QPointF> points(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            const qreal x = static_cast<qreal>(i) / static_cast<qreal>(count) * 100;
+            points[i] = QPointF(x, std::sin(x * (1.0 + index * 0.37) * 0.2) + index);
+        }
+        return points;
+    }
+}
+
+class AllocationTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void stationaryFrameOnlyPostsItsEvent();
+
+    void movingFrameStaysWithinBudget();
+
+    void cleanupTestCase();
+
+private:
+    ZoomAndScroll *m_view = nullptr;
+    QPointF m_pos; // Viewport position over the plot's center
+    QTimer m_wakeUp; // The waits below return even if no frame comes
+    MoveWindow m_window;
+    quint64 m_rendered = 0;
+
+    // Sends one move at offset pixels right of the center and waits for its
+    // batch to be rendered; counted moves open the counting window.
+    bool frame(qreal offset, bool counted);
+
+    // Counted allocations over frames moves at the given offsets
+    quint64 countFrames(int frames, const std::function<qreal(int)> &offset);
+};
+
+void AllocationTest::initTestCase() {
+#if !defined(__GLIBC__)
+    QSKIP("The allocation hook needs glibc");
+#endif
+    auto *chart = new QChart();
+    m_view = new ZoomAndScroll(chart);
+    ZoomAndScroll &view = *m_view;
+    chart->addSeries(new LineSeries(&view));
+    chart->addSeries(new LineSeries(&view));
+    chart->addSeries(new SplineSeries(&view));
+    for (int i = 0; i < chart->series().size(); ++i) {
+        static_cast<QXYSeries *>(chart->series()[i])->replace(makeSeries(10000, i));
+    }
+    view.updateXLimits(chart);
+    chart->createDefaultAxes();
+    for (QAbstractAxis *axis: chart->axes()) {
+        if (auto *valueAxis = qobject_cast<QValueAxis *>(axis)) {
+            if (axis->orientation() == Qt::Horizontal) {
+                valueAxis->setRange(view.minX, view.maxX);
+            } else {
+                valueAxis->setRange(view.minY, view.maxY);
+            }
+        }
+    }
+    view.rangeUpdate();
+    view.resize(1024, 768);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // Full quality throughout, no expiry re-arm during the run, and a frame
+    // interval long enough for each move to arrive before the next tick (the
+    // view stays active, so no timer is restarted between frames)
+    view.setFrameBudget(-1);
+    view.setLabelTimeout(60 * 1000);
+    FrameScheduler::instance()->setFrameInterval(16);
+    view.toggleState = true;
+    view.toggleLines = true;
+
+    connect(FrameScheduler::instance(), &FrameScheduler::batchFinished, this, [this]() {
+        counting.store(false, std::memory_order_relaxed);
+        ++m_rendered;
+    });
+    view.viewport()->installEventFilter(&m_window);
+    m_wakeUp.start(50);
+    m_pos = view.mapFromScene(chart->plotArea().center());
+
+    // Warm-up: overlays, labels, worker thread and buffers are created here,
+    // over the whole sweep used below so every label width has been seen
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(frame(i % 50 - 25, false));
+    }
+    QVERIFY(view.bottomSlot() >= 0); // The cursor does intersect the series
+}
+
+bool AllocationTest::frame(const qreal offset, const bool counted) {
+    const QPointF pos = m_pos + QPointF(offset, 0);
+    const QPointF globalPos = m_view->viewport()->mapToGlobal(pos);
+    QMouseEvent event(QEvent::MouseMove, pos, globalPos, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    m_window.armed = counted;
+    const quint64 before = m_rendered;
+    QCoreApplication::sendEvent(m_view->viewport(), &event);
+    const QDeadlineTimer deadline(1000);
+    while (m_rendered == before && !deadline.hasExpired()) {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    counting.store(false, std::memory_order_relaxed);
+    return m_rendered != before;
+}
+
+quint64 AllocationTest::countFrames(const int frames, const std::function<qreal(int)> &offset) {
+    allocations.store(0);
+    for (int i = 0; i < frames; ++i) {
+        if (!frame(offset(i), true)) {
+            return ~quint64{0};
+        }
+    }
+    return allocations.load();
+}
+
+void AllocationTest::stationaryFrameOnlyPostsItsEvent() {
+    constexpr int frames = 100;
+    QVERIFY(frame(0, false)); // Overlays already at the center
+    const quint64 counted = countFrames(frames, [](int) { return 0.0; });
+    // The worker posts one completion event per batch; nothing else
+    QCOMPARE(counted, quint64{frames});
+}
+
+void AllocationTest::movingFrameStaysWithinBudget() {
+    // A new pixel every frame: every label text and line changes. The budget
+    // covers Qt's per-update work for the three series' nine labels and their
+    // lines; anything done per point (each series holds 10k) exceeds it.
+    constexpr int frames = 100;
+    constexpr quint64 budgetPerFrame = 128;
+    const quint64 counted = countFrames(frames, [](const int i) { return static_cast<qreal>(i % 50 - 25); });
+    qInfo("%llu allocations over %d moving frames", static_cast<unsigned long long>(counted), frames);
+    QVERIFY(counted <= budgetPerFrame * frames);
+}
+
+void AllocationTest::cleanupTestCase() {
+    delete m_view;
+}
+
+QTEST_MAIN(AllocationTest)
+
+#include "allocationTest.moc"
@@ -0,0 +1,126 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// trackplotRender smoke test: the tool is run on plain "x,y" and exported
+// "series,x,y" datasets and must write one PNG of the requested size each;
+// an unreadable dataset fails the run without stopping the others.
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTest>
+#include <cmath>
+
+namespace {
+    bool writeCsv(const QString &path, const QByteArray &header, const QList<QByteArray> &names,
+                  const qsizetype rows) {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+        QByteArray content = header;
+        for (qsizetype s = 0; s < names.size(); ++s) {
+            for (qsizetype i = 0; i < rows; ++i) {
+                const qreal x = static_cast<qreal>(i) * 0.01;
+                const QByteArray row = QByteArray::number(x) + ',' + QByteArray::number(std::sin(x) + s) + '\n';
+                content += names[s].isEmpty() ? row : names[s] + ',' + row;
+            }
+        }
+        return file.write(content) == content.size();
+    }
+}
+
+class BatchRenderTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void rendersEachDatasetAtTheRequestedSize();
+
+    void reportsUnreadableDatasets();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_plain;
+    QString m_exported;
+
+    // Runs the tool; false if it did not finish
+    bool run(const QStringList &arguments, int &exitCode, QByteArray &output, QByteArray &errors) const;
+};
+
+void BatchRenderTest::initTestCase() {
+    QVERIFY(m_dir.isValid());
+    m_plain = m_dir.filePath(QStringLiteral("plain.csv"));
+    m_exported = m_dir.filePath(QStringLiteral("exported.csv"));
+    QVERIFY(writeCsv(m_plain, QByteArray(), {QByteArray()}, 5000));
+    QVERIFY(writeCsv(m_exported, QByteArrayLiteral("series,x,y\n"),
+                     {QByteArrayLiteral("first"), QByteArrayLiteral("\"second, quoted\"")}, 2000));
+}
+
+bool BatchRenderTest::run(const QStringList &arguments, int &exitCode, QByteArray &output,
+                          QByteArray &errors) const {
+    QProcess process;
+    process.start(QStringLiteral(TRACKPLOT_RENDER), arguments);
+    if (!process.waitForFinished(60 * 1000) || process.exitStatus() != QProcess::NormalExit) {
+        return false;
+    }
+    exitCode = process.exitCode();
+    output = process.readAllStandardOutput();
+    errors = process.readAllStandardError();
+    return true;
+}
+
+void BatchRenderTest::rendersEachDatasetAtTheRequestedSize() {
+    const QString out = m_dir.filePath(QStringLiteral("images"));
+    int exitCode = -1;
+    QByteArray output;
+    QByteArray errors;
+    QVERIFY(run({QStringLiteral("--size"), QStringLiteral("640x360"), QStringLiteral("--in-flight"),
+                 QStringLiteral("1"), QStringLiteral("--out"), out, m_plain, m_exported},
+                exitCode, output, errors));
+    QVERIFY2(exitCode == 0, errors.constData());
+    for (const QString &name: {QStringLiteral("plain"), QStringLiteral("exported")}) {
+        const QString image = QDir(out).filePath(name + QStringLiteral(".png"));
+        QVERIFY2(QFile::exists(image), qPrintable(image));
+        QCOMPARE(QImage(image).size(), QSize(640, 360));
+    }
+    QVERIFY(output.contains(m_plain.toUtf8()) && output.contains(m_exported.toUtf8()));
+}
+
+void BatchRenderTest::reportsUnreadableDatasets() {
+    const QString out = m_dir.filePath(QStringLiteral("partial"));
+    const QString missing = m_dir.filePath(QStringLiteral("missing.csv"));
+    int exitCode = -1;
+    QByteArray output;
+    QByteArray errors;
+    QVERIFY(run({QStringLiteral("--size"), QStringLiteral("320x240"), QStringLiteral("--out"), out, missing,
+                 m_plain},
+                exitCode, output, errors));
+    QCOMPARE(exitCode, 1);
+    QVERIFY(errors.contains(missing.toUtf8()));
+    QCOMPARE(QImage(QDir(out).filePath(QStringLiteral("plain.png"))).size(), QSize(320, 240));
+    QVERIFY(!QFile::exists(QDir(out).filePath(QStringLiteral("missing.png"))));
+}
+
+QTEST_GUILESS_MAIN(BatchRenderTest)
+
+#include "batchRenderTest.moc"
@@ -0,0 +1,186 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// BlockStore: the compression is lossless across block boundaries and the
+// open tail, searches and summaries match a plain scan of the input, and
+// snapshots do not see later appends.
+
+#include "blockStore.h"
+#include <QTest>
+#include <cmath>
+
+namespace {
+    // Sample clock with some jitter (x stays ascending), noisy y
+    QList<QPointF> recording(const qsizetype count, const qreal x0 = 0) {
+        QList<QPointF> points(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            const qreal x = x0 + static_cast<qreal>(i) * 1e-3 + ((i * 7919) % 13) * 1e-6;
+            points[i] = QPointF(x, std::sin(x * 40) * 5 + ((i * 104729) % 97) * 0.01);
+        }
+        return points;
+    }
+
+    // Uneven chunks, so blocks close in the middle of an append
+    void appendAll(BlockStore &store, const QList<QPointF> &points) {
+        qsizetype i = 0;
+        for (qsizetype chunk = 1; i < points.size(); chunk = chunk * 3 + 1) {
+            const qsizetype n = std::min(chunk, points.size() - i);
+            store.append(points.mid(i, n));
+            i += n;
+        }
+    }
+}
+
+class BlockStoreTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTripIsLossless();
+
+    void summariesMatchTheSamples();
+
+    void lowerBoundMatchesScan();
+
+    void uniformClockCompresses();
+
+    void snapshotIgnoresLaterAppends();
+
+    void viewKeepsTheExtremes();
+
+    void trackSegmentDecodesTheBlock();
+};
+
+void BlockStoreTest::roundTripIsLossless() {
+    const QList<QPointF> points = recording(3 * BlockStore::blockSamples + 123);
+    BlockStore store;
+    appendAll(store, points);
+    QCOMPARE(store.size(), points.size());
+    QCOMPARE(store.blockCount(), qsizetype{4}); // Three closed, one open
+    QCOMPARE(store.mid(0, store.size()), points); // Bit-exact
+    for (const qsizetype i: {qsizetype{0}, BlockStore::blockSamples - 1, BlockStore::blockSamples,
+                             2 * BlockStore::blockSamples + 17, points.size() - 1}) {
+        QCOMPARE(store.at(i), points[i]);
+    }
+    // Straddling a block boundary
+    QCOMPARE(store.mid(BlockStore::blockSamples - 5, 10), points.mid(BlockStore::blockSamples - 5, 10));
+}
+
+void BlockStoreTest::summariesMatchTheSamples() {
+    const QList<QPointF> points = recording(2 * BlockStore::blockSamples + 10);
+    BlockStore store;
+    appendAll(store, points);
+    qreal yMin = points.first().y();
+    qreal yMax = yMin;
+    for (qsizetype b = 0; b < store.blockCount(); ++b) {
+        const BlockStore::BlockSummary &s = store.summary(b);
+        QCOMPARE(s.first, b * BlockStore::blockSamples);
+        QCOMPARE(s.count, std::min(BlockStore::blockSamples, points.size() - s.first));
+        QCOMPARE(s.xFirst, points[s.first].x());
+        QCOMPARE(s.xLast, points[s.first + s.count - 1].x());
+        const QList<QPointF> block = points.mid(s.first, s.count);
+        const auto [low, high] = std::minmax_element(block.cbegin(), block.cend(), [](const QPointF &a, const QPointF &c) {
+            return a.y() < c.y();
+        });
+        QCOMPARE(s.minPoint.y(), low->y());
+        QCOMPARE(s.maxPoint.y(), high->y());
+        yMin = std::min(yMin, low->y());
+        yMax = std::max(yMax, high->y());
+    }
+    QCOMPARE(store.bounds(), QRectF(QPointF(points.first().x(), yMin), QPointF(points.last().x(), yMax)));
+}
+
+void BlockStoreTest::lowerBoundMatchesScan() {
+    const QList<QPointF> points = recording(2 * BlockStore::blockSamples + 500);
+    BlockStore store;
+    appendAll(store, points);
+    const auto byX = [](const QPointF &p, const qreal x) { return p.x() < x; };
+    const qreal xMin = points.first().x() - 1;
+    const qreal xMax = points.last().x() + 1;
+    for (int v = 0; v <= 1000; ++v) {
+        const qreal value = xMin + (xMax - xMin) * v / 1000;
+        const qsizetype expected = std::min<qsizetype>(
+            points.size() - 1, std::lower_bound(points.cbegin(), points.cend(), value, byX) - points.cbegin());
+        QCOMPARE(store.lowerBound(value), expected);
+    }
+    // Exact sample values, including the first one of each block
+    for (const qsizetype i: {qsizetype{0}, BlockStore::blockSamples, 2 * BlockStore::blockSamples + 3}) {
+        QCOMPARE(store.lowerBound(points[i].x()), i);
+    }
+}
+
+void BlockStoreTest::uniformClockCompresses() {
+    QList<QPointF> points(4 * BlockStore::blockSamples);
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        points[i] = QPointF(static_cast<qreal>(i) * 0.5, static_cast<qreal>((i / 64) % 4)); // Exact clock, step signal
+    }
+    BlockStore store;
+    store.append(points);
+    QCOMPARE(store.mid(0, store.size()), points);
+    QVERIFY(store.storedBytes() < points.size() * static_cast<qsizetype>(sizeof(QPointF)) / 4);
+}
+
+void BlockStoreTest::snapshotIgnoresLaterAppends() {
+    const QList<QPointF> points = recording(BlockStore::blockSamples + 100);
+    BlockStore store;
+    appendAll(store, points);
+    const std::shared_ptr<const BlockStore> snapshot = store.snapshot();
+    const QList<QPointF> more = recording(BlockStore::blockSamples, points.last().x() + 1);
+    store.append(more); // Closes the open block the snapshot shares
+    QCOMPARE(snapshot->size(), points.size());
+    QCOMPARE(snapshot->blockCount(), qsizetype{2});
+    QCOMPARE(snapshot->mid(0, snapshot->size()), points);
+    QCOMPARE(store.size(), points.size() + more.size());
+    QCOMPARE(store.mid(points.size(), more.size()), more);
+}
+
+void BlockStoreTest::viewKeepsTheExtremes() {
+    const QList<QPointF> points = recording(8 * BlockStore::blockSamples);
+    BlockStore store;
+    appendAll(store, points);
+    const QRectF bounds = store.bounds();
+    const QList<QPointF> view = store.view(bounds.left(), bounds.right(), 4); // Wider columns than blocks
+    QVERIFY(!view.isEmpty());
+    QVERIFY(view.size() <= 2 * store.blockCount());
+    const auto [low, high] = std::minmax_element(view.cbegin(), view.cend(), [](const QPointF &a, const QPointF &c) {
+        return a.y() < c.y();
+    });
+    QCOMPARE(low->y(), bounds.top());
+    QCOMPARE(high->y(), bounds.bottom());
+    for (qsizetype i = 1; i < view.size(); ++i) {
+        QVERIFY(view[i - 1].x() <= view[i].x());
+    }
+}
+
+void BlockStoreTest::trackSegmentDecodesTheBlock() {
+    const QList<QPointF> points = recording(2 * BlockStore::blockSamples);
+    BlockStore store;
+    appendAll(store, points);
+    qsizetype hint = -1;
+    for (const qsizetype i: {qsizetype{3}, BlockStore::blockSamples - 1, BlockStore::blockSamples + 40}) {
+        const qreal x = (points[i].x() + points[i + 1].x()) / 2;
+        const SegmentHit hit = trackSegment<LinearInterpolation>(store, QPointF(x, 0), false, hint);
+        QVERIFY(hit.isValid);
+        QCOMPARE(hit.index, i);
+        QVERIFY(std::abs(hit.pos.y() - (points[i].y() + points[i + 1].y()) / 2) <= 1e-12);
+    }
+}
+
+QTEST_GUILESS_MAIN(BlockStoreTest)
+
+#include "blockStoreTest.moc"
@@ -0,0 +1,156 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// CompactSamples: every encoding decodes back to the points it was built
+// from (exactly, or within its quantization step), and the galloping search
+// agrees with the plain one wherever it starts.
+
+#include "compactSamples.h"
+#include <QTest>
+#include <cmath>
+
+namespace {
+    QList<QPointF> irregularPoints(const qsizetype count) {
+        QList<QPointF> points(count);
+        qreal x = -50;
+        for (qsizetype i = 0; i < count; ++i) {
+            x += 0.1 + 0.05 * static_cast<qreal>(i % 7); // Ascending, not uniform
+            points[i] = QPointF(x, 20 * std::sin(x * 0.3) + 3);
+        }
+        return points;
+    }
+}
+
+class CompactSamplesTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void uniformFloatRoundTrip();
+
+    void uniformInt16Scaling();
+
+    void fromPointsDetectsUniformClock();
+
+    void fromPointsFloat32RoundTrip();
+
+    void fromPointsInt16WithinStep();
+
+    void gallopMatchesBinarySearch();
+
+    void trackSegmentInterpolates();
+};
+
+void CompactSamplesTest::uniformFloatRoundTrip() {
+    const QList<float> values{1.5f, -2.25f, 8.0f, 0.0f};
+    const CompactSamples samples = CompactSamples::uniform(10, 0.5, values);
+    QCOMPARE(samples.xEncoding(), CompactSamples::XEncoding::Implicit);
+    QCOMPARE(samples.yEncoding(), CompactSamples::YEncoding::Float32);
+    QCOMPARE(samples.size(), values.size());
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        QCOMPARE(samples.x(i), 10 + 0.5 * static_cast<qreal>(i));
+        QCOMPARE(samples.y(i), static_cast<qreal>(values[i]));
+    }
+    QCOMPARE(samples.bounds(), QRectF(QPointF(10, -2.25), QPointF(11.5, 8)));
+    QCOMPARE(samples.mid(1, 2), (QList<QPointF>{{10.5, -2.25}, {11, 8}}));
+}
+
+void CompactSamplesTest::uniformInt16Scaling() {
+    const QList<qint16> raw{-100, 0, 250};
+    const CompactSamples samples = CompactSamples::uniform(0, 1e-3, raw, 0.01, 5);
+    QCOMPARE(samples.yEncoding(), CompactSamples::YEncoding::Int16);
+    QCOMPARE(samples.y(0), 4.0);
+    QCOMPARE(samples.y(1), 5.0);
+    QCOMPARE(samples.y(2), 7.5);
+    QCOMPARE(samples.bytes(), raw.size() * static_cast<qsizetype>(sizeof(qint16)));
+}
+
+void CompactSamplesTest::fromPointsDetectsUniformClock() {
+    QList<QPointF> points;
+    for (int i = 0; i < 1000; ++i) {
+        points.append({0.25 * i, std::cos(i * 0.01)});
+    }
+    const CompactSamples samples = CompactSamples::fromPoints(points);
+    QCOMPARE(samples.xEncoding(), CompactSamples::XEncoding::Implicit);
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        QVERIFY(std::abs(samples.x(i) - points[i].x()) <= 1e-9);
+    }
+}
+
+void CompactSamplesTest::fromPointsFloat32RoundTrip() {
+    const QList<QPointF> points = irregularPoints(5000);
+    const CompactSamples samples = CompactSamples::fromPoints(points);
+    QCOMPARE(samples.xEncoding(), CompactSamples::XEncoding::Float32);
+    QCOMPARE(samples.size(), points.size());
+    // float32 offsets from the first x and from the y midrange
+    const QRectF bounds = samples.bounds();
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        QVERIFY(std::abs(samples.x(i) - points[i].x()) <= 1e-4);
+        QVERIFY(std::abs(samples.y(i) - points[i].y()) <= 1e-5);
+    }
+    QCOMPARE(bounds.left(), points.first().x());
+    QVERIFY(std::abs(bounds.right() - points.last().x()) <= 1e-4);
+    QCOMPARE(samples.bytes(), points.size() * 2 * static_cast<qsizetype>(sizeof(float))); // Half of QPointF
+}
+
+void CompactSamplesTest::fromPointsInt16WithinStep() {
+    const QList<QPointF> points = irregularPoints(5000);
+    const CompactSamples samples = CompactSamples::fromPoints(points, CompactSamples::YEncoding::Int16);
+    QCOMPARE(samples.yEncoding(), CompactSamples::YEncoding::Int16);
+    const QRectF bounds = samples.bounds();
+    const qreal halfStep = bounds.height() / 65534 / 2;
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        QVERIFY(std::abs(samples.y(i) - points[i].y()) <= halfStep * 1.0001);
+    }
+}
+
+void CompactSamplesTest::gallopMatchesBinarySearch() {
+    const QList<QPointF> points = irregularPoints(3000);
+    const CompactSamples samples = CompactSamples::fromPoints(points);
+    const qreal xMin = points.first().x() - 1;
+    const qreal xMax = points.last().x() + 1;
+    for (int v = 0; v <= 400; ++v) {
+        const qreal value = xMin + (xMax - xMin) * v / 400;
+        const qsizetype expected = samples.lowerBound(value);
+        for (const qsizetype hint: {qsizetype{0}, expected, expected + 1, expected - 3, qsizetype{1500},
+                                    points.size() - 1, points.size() + 10}) {
+            QCOMPARE(samples.lowerBound(value, hint), expected);
+        }
+    }
+}
+
+void CompactSamplesTest::trackSegmentInterpolates() {
+    const QList<QPointF> points = irregularPoints(2000);
+    const CompactSamples samples = CompactSamples::fromPoints(points);
+    qsizetype hint = -1;
+    for (const qsizetype i: {qsizetype{10}, qsizetype{11}, qsizetype{900}, qsizetype{5}}) {
+        const qreal x = (samples.x(i) + samples.x(i + 1)) / 2;
+        const SegmentHit hit = trackSegment<LinearInterpolation>(samples, QPointF(x, 0), false, hint);
+        QVERIFY(hit.isValid);
+        QCOMPARE(hit.index, i);
+        QCOMPARE(hint, i); // Seeds the next search
+        QVERIFY(std::abs(hit.pos.y() - (samples.y(i) + samples.y(i + 1)) / 2) <= 1e-9);
+    }
+    const SegmentHit outside = trackSegment<LinearInterpolation>(samples, QPointF(samples.bounds().right() + 1, 0),
+                                                                 false, hint);
+    QVERIFY(!outside.isValid);
+}
+
+QTEST_GUILESS_MAIN(CompactSamplesTest)
+
+#include "compactSamplesTest.moc"
@@ -0,0 +1,253 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// DatasetIndex: the built index matches a scan of the points, a saved
+// sidecar maps back to the same index, stale, foreign or damaged sidecars
+// are rejected (open() then rebuilds), and the keys track what they claim.
+
+#include "datasetIndex.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    QList<QPointF> signal(const qsizetype count) {
+        QList<QPointF> points(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            const qreal x = static_cast<qreal>(i) * 0.01;
+            points[i] = QPointF(x, std::sin(x) * 10 + std::cos(x * 7));
+        }
+        return points;
+    }
+
+    qreal sumOfY(const QList<QPointF> &points, const qsizetype from, const qsizetype to) {
+        qreal sum = 0;
+        for (qsizetype i = from; i < to; ++i) {
+            sum += points[i].y();
+        }
+        return sum;
+    }
+
+    bool sameBuckets(const DatasetIndex &a, const DatasetIndex &b) {
+        if (a.levels() != b.levels()) {
+            return false;
+        }
+        for (int l = 0; l < a.levels(); ++l) {
+            const auto x = a.level(l);
+            const auto y = b.level(l);
+            if (x.size() != y.size() ||
+                !std::equal(x.begin(), x.end(), y.begin(), [](const DatasetIndex::Bucket &p, const DatasetIndex::Bucket &q) {
+                    return p.xFirst == q.xFirst && p.xLast == q.xLast && p.minPoint == q.minPoint &&
+                           p.maxPoint == q.maxPoint;
+                })) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+class DatasetIndexTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void buildMatchesScan();
+
+    void saveThenLoadMapsTheSameIndex();
+
+    void openReusesTheSidecar();
+
+    void rejectsAnotherKey();
+
+    void rejectsDamagedSidecars();
+
+    void flagsUnsortedData();
+
+    void keysTrackTheirInputs();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_path;
+    QList<QPointF> m_points;
+    QByteArray m_key;
+};
+
+void DatasetIndexTest::init() {
+    QVERIFY(m_dir.isValid());
+    m_path = m_dir.filePath(QStringLiteral("data.tpix"));
+    QFile::remove(m_path);
+    m_points = signal(100 * DatasetIndex::baseBucketSamples + 77);
+    m_key = DatasetIndex::contentKey(m_points);
+}
+
+void DatasetIndexTest::buildMatchesScan() {
+    DatasetIndex index;
+    index.build(m_points, m_key);
+    QVERIFY(index.isValid());
+    QVERIFY(!index.isMapped());
+    QCOMPARE(index.count(), static_cast<qint64>(m_points.size()));
+    QVERIFY(index.ascending());
+
+    const auto [low, high] = std::minmax_element(m_points.cbegin(), m_points.cend(), [](const QPointF &a, const QPointF &b) {
+        return a.y() < b.y();
+    });
+    QCOMPARE(index.bounds(), QRectF(QPointF(m_points.first().x(), low->y()), QPointF(m_points.last().x(), high->y())));
+
+    // Level 0 has one bucket per baseBucketSamples samples, the top one covers everything
+    const qint64 buckets = (m_points.size() + DatasetIndex::baseBucketSamples - 1) / DatasetIndex::baseBucketSamples;
+    QCOMPARE(static_cast<qint64>(index.level(0).size()), buckets);
+    QCOMPARE(index.level(index.levels() - 1).size(), std::size_t{1});
+    QCOMPARE(index.level(index.levels() - 1)[0].minPoint, *low);
+    QCOMPARE(index.level(index.levels() - 1)[0].maxPoint, *high);
+
+    // Prefix sums of y over whole buckets
+    constexpr qint64 b = DatasetIndex::baseBucketSamples;
+    QVERIFY(std::abs(index.bucketSum(0, buckets) - sumOfY(m_points, 0, m_points.size())) <= 1e-6);
+    QVERIFY(std::abs(index.bucketSum(3, 11) - sumOfY(m_points, 3 * b, 11 * b)) <= 1e-6);
+    QCOMPARE(index.bucketSum(5, 5), 0.0);
+
+    // The overview outline reaches the extremes of the data
+    const QList<QPointF> outline = index.overview(index.bounds().left(), index.bounds().right(), 16);
+    QVERIFY(!outline.isEmpty());
+    QVERIFY(outline.contains(*low));
+    QVERIFY(outline.contains(*high));
+}
+
+void DatasetIndexTest::saveThenLoadMapsTheSameIndex() {
+    DatasetIndex built;
+    built.build(m_points, m_key);
+    QVERIFY(built.save(m_path));
+
+    DatasetIndex loaded;
+    QVERIFY(loaded.load(m_path, m_key));
+    QVERIFY(loaded.isMapped());
+    QCOMPARE(loaded.count(), built.count());
+    QCOMPARE(loaded.ascending(), built.ascending());
+    QCOMPARE(loaded.bounds(), built.bounds());
+    QVERIFY(sameBuckets(loaded, built));
+    QCOMPARE(loaded.bucketSum(0, 40), built.bucketSum(0, 40));
+}
+
+void DatasetIndexTest::openReusesTheSidecar() {
+    DatasetIndex first;
+    QVERIFY(first.open(m_path, m_points));
+    QVERIFY(!first.isMapped()); // Built, and the sidecar written
+    QVERIFY(QFile::exists(m_path));
+
+    DatasetIndex second;
+    QVERIFY(second.open(m_path, m_points));
+    QVERIFY(second.isMapped());
+    QVERIFY(sameBuckets(first, second));
+
+    // Other data, same path: the stale sidecar is rebuilt and replaced
+    const QList<QPointF> other = signal(1000);
+    DatasetIndex third;
+    QVERIFY(third.open(m_path, other));
+    QVERIFY(!third.isMapped());
+    QCOMPARE(third.count(), static_cast<qint64>(other.size()));
+    DatasetIndex fourth;
+    QVERIFY(fourth.open(m_path, other));
+    QVERIFY(fourth.isMapped());
+}
+
+void DatasetIndexTest::rejectsAnotherKey() {
+    DatasetIndex built;
+    built.build(m_points, m_key);
+    QVERIFY(built.save(m_path));
+
+    DatasetIndex loaded;
+    QVERIFY(!loaded.load(m_path, QByteArrayLiteral("acquisition-42")));
+    QVERIFY(!loaded.isValid());
+    QVERIFY(!loaded.load(m_path + QStringLiteral(".missing"), m_key));
+}
+
+void DatasetIndexTest::rejectsDamagedSidecars() {
+    DatasetIndex built;
+    built.build(m_points, m_key);
+    QVERIFY(built.save(m_path));
+    QFile file(m_path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray bytes = file.readAll();
+    file.close();
+
+    const auto rejected = [this](const QByteArray &content) {
+        QFile damaged(m_path);
+        if (!damaged.open(QIODevice::WriteOnly | QIODevice::Truncate) || damaged.write(content) != content.size()) {
+            return false;
+        }
+        damaged.close();
+        DatasetIndex index;
+        return !index.load(m_path, m_key) && !index.isValid();
+    };
+    QVERIFY(rejected(bytes.left(bytes.size() / 2))); // Truncated pyramid
+    QVERIFY(rejected(bytes.left(16))); // Shorter than the header
+    QByteArray foreign = bytes;
+    foreign[0] = 'X'; // Magic
+    QVERIFY(rejected(foreign));
+    QByteArray newer = bytes;
+    const quint32 version = DatasetIndex::formatVersion + 1; // Native byte order, after the magic
+    std::memcpy(newer.data() + 4, &version, sizeof(version));
+    QVERIFY(rejected(newer));
+}
+
+void DatasetIndexTest::flagsUnsortedData() {
+    QList<QPointF> points = signal(5000);
+    std::reverse(points.begin(), points.end());
+    DatasetIndex index;
+    index.build(points, DatasetIndex::contentKey(points));
+    QVERIFY(index.isValid());
+    QVERIFY(!index.ascending());
+    QVERIFY(index.overview(0, 50, 10).isEmpty()); // Needs ascending x
+    QCOMPARE(index.bounds().left(), 0.0);
+    QCOMPARE(index.bounds().right(), points.first().x());
+}
+
+void DatasetIndexTest::keysTrackTheirInputs() {
+    QCOMPARE(DatasetIndex::sampledKey(m_points), DatasetIndex::sampledKey(signal(m_points.size())));
+    QVERIFY(DatasetIndex::sampledKey(m_points) != DatasetIndex::sampledKey(signal(m_points.size() + 1)));
+
+    // A sampled point changes the sampled key; one between samples only the full hash
+    QList<QPointF> edited = m_points;
+    edited.last().ry() += 1;
+    QVERIFY(DatasetIndex::sampledKey(edited) != DatasetIndex::sampledKey(m_points));
+    edited = m_points;
+    edited[1].ry() += 1;
+    QCOMPARE(DatasetIndex::sampledKey(edited), DatasetIndex::sampledKey(m_points));
+    QVERIFY(DatasetIndex::contentKey(edited) != DatasetIndex::contentKey(m_points));
+
+    // Rewriting the data file (another size) changes the file key
+    const QString dataPath = m_dir.filePath(QStringLiteral("data.csv"));
+    const auto write = [&dataPath](const QByteArray &content) {
+        QFile file(dataPath);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(content) == content.size();
+    };
+    QVERIFY(write(QByteArrayLiteral("0,1\n")));
+    const QByteArray before = DatasetIndex::fileKey(dataPath, m_points);
+    QCOMPARE(DatasetIndex::fileKey(dataPath, m_points), before);
+    QVERIFY(write(QByteArrayLiteral("0,1\n1,2\n")));
+    QVERIFY(DatasetIndex::fileKey(dataPath, m_points) != before);
+}
+
+QTEST_GUILESS_MAIN(DatasetIndexTest)
+
+#include "datasetIndexTest.moc"
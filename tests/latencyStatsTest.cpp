@@ -0,0 +1,123 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// LatencyHistogram: buckets tile the value range without gaps and stay
+// within 25% of their lower bound, and percentiles read back the bucket
+// bound of the requested rank, never above the recorded maximum.
+
+#include "latencyStats.h"
+#include <QTest>
+#include <cmath>
+
+namespace {
+    // Exact p-quantile of 1..n, same rank rule as the histogram
+    quint64 exactRank(const quint64 n, const double p) {
+        return std::max<quint64>(1, static_cast<quint64>(std::ceil(p * static_cast<double>(n))));
+    }
+}
+
+static_assert(LatencyHistogram::bucketOf(0) == 0 && LatencyHistogram::bucketOf(3) == 3);
+static_assert(LatencyHistogram::bucketOf(4) == 4 && LatencyHistogram::bucketOf(7) == 7);
+static_assert(LatencyHistogram::bucketOf(8) == 8 && LatencyHistogram::bucketOf(15) == 11);
+static_assert(LatencyHistogram::bucketOf(~quint64{0}) < LatencyHistogram::bucketCount);
+
+class LatencyStatsTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void bucketsTileTheRange();
+
+    void percentileOfEmptyIsZero();
+
+    void percentileBoundsTheExactValue();
+
+    void percentileNeverExceedsMaximum();
+
+    void resetClearsEverything();
+};
+
+void LatencyStatsTest::bucketsTileTheRange() {
+    const int last = LatencyHistogram::bucketOf(~quint64{0});
+    QCOMPARE(LatencyHistogram::bucketUpperBound(last), ~quint64{0});
+    quint64 lower = 0;
+    for (int b = 0; b <= last; ++b) {
+        const quint64 upper = LatencyHistogram::bucketUpperBound(b);
+        QVERIFY(upper >= lower);
+        QCOMPARE(LatencyHistogram::bucketOf(lower), b);
+        QCOMPARE(LatencyHistogram::bucketOf(upper), b);
+        if (lower >= 4) {
+            QVERIFY(upper - lower + 1 <= lower / 4); // Log-linear: 4 per power of two
+        }
+        lower = upper + 1; // Next bucket starts right after: no gaps
+    }
+    QCOMPARE(lower, quint64{0}); // Wrapped past the largest value
+}
+
+void LatencyStatsTest::percentileOfEmptyIsZero() {
+    const LatencyHistogram histogram;
+    QCOMPARE(histogram.percentile(0.5), qint64{0});
+    QCOMPARE(histogram.mean(), qint64{0});
+    QCOMPARE(histogram.count(), quint64{0});
+}
+
+void LatencyStatsTest::percentileBoundsTheExactValue() {
+    LatencyHistogram histogram;
+    constexpr quint64 n = 100000;
+    for (quint64 v = 1; v <= n; ++v) {
+        histogram.record(static_cast<qint64>(v));
+    }
+    QCOMPARE(histogram.count(), n);
+    QCOMPARE(histogram.maximum(), static_cast<qint64>(n));
+    QCOMPARE(histogram.mean(), static_cast<qint64>((n + 1) / 2));
+    for (const double p: {0.001, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+        const auto exact = static_cast<qint64>(exactRank(n, p)); // The value at that rank is the rank itself
+        const qint64 estimate = histogram.percentile(p);
+        QVERIFY2(estimate >= exact && estimate <= exact + exact / 4,
+                 qPrintable(QStringLiteral("p=%1 exact=%2 estimate=%3").arg(p).arg(exact).arg(estimate)));
+        const quint64 bound = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketOf(exactRank(n, p)));
+        QCOMPARE(estimate, static_cast<qint64>(std::min(bound, n)));
+    }
+}
+
+void LatencyStatsTest::percentileNeverExceedsMaximum() {
+    LatencyHistogram histogram;
+    histogram.record(1000); // Bucket [896, 1023]
+    QCOMPARE(histogram.percentile(0.5), qint64{1000});
+    QCOMPARE(histogram.percentile(1.0), qint64{1000});
+    histogram.record(-5); // Clamped to 0
+    QCOMPARE(histogram.percentile(0.5), qint64{0});
+    QCOMPARE(histogram.percentile(1.0), qint64{1000});
+}
+
+void LatencyStatsTest::resetClearsEverything() {
+    LatencyHistogram histogram;
+    for (qint64 v = 0; v < 1000; ++v) {
+        histogram.record(v * 1000);
+    }
+    histogram.reset();
+    QCOMPARE(histogram.count(), quint64{0});
+    QCOMPARE(histogram.maximum(), qint64{0});
+    QCOMPARE(histogram.percentile(0.99), qint64{0});
+    histogram.record(42);
+    QCOMPARE(histogram.percentile(0.5), qint64{42});
+}
+
+QTEST_GUILESS_MAIN(LatencyStatsTest)
+
+#include "latencyStatsTest.moc"
@@ -0,0 +1,288 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// SeriesExporter: the CSV and binary files hold every sample of the point,
+// compact and block storages, in the documented layout, and a Visible export
+// keeps only the view's x range (filtering unsorted series).
+
+#include "blockStore.h"
+#include "seriesExporter.h"
+#include <QApplication>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QValueAxis>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+    struct Column {
+        QString name;
+        QList<QPointF> points;
+    };
+
+    QList<QPointF> ramp(const qsizetype count, const qreal step) {
+        QList<QPointF> points(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            points[i] = QPointF(static_cast<qreal>(i) * step, static_cast<qreal>(i % 17) - 8.25);
+        }
+        return points;
+    }
+
+    QList<QPointF> inRange(const QList<QPointF> &points, const qreal xMin, const qreal xMax) {
+        QList<QPointF> kept;
+        for (const QPointF &p: points) {
+            if (p.x() >= xMin && p.x() <= xMax) {
+                kept.append(p);
+            }
+        }
+        return kept;
+    }
+
+    // Runs one export to completion; the error string is empty on success
+    QString exportTo(ZoomAndScroll &view, const QString &path, const QList<QXYSeries *> &series,
+                     const SeriesExporter::Format format, const SeriesExporter::Range range) {
+        SeriesExporter exporter(&view);
+        QSignalSpy done(&exporter, &SeriesExporter::finished);
+        if (!exporter.start(path, series, format, range)) {
+            return QStringLiteral("not started");
+        }
+        if (!done.wait(10000)) {
+            return QStringLiteral("timed out");
+        }
+        return done.first().at(1).toString();
+    }
+
+    QByteArray contents(const QString &path) {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    // Rows grouped by series, in file order; empty on a malformed file
+    QList<Column> parseCsv(const QByteArray &data) {
+        QList<QByteArray> lines = data.split('\n');
+        if (lines.isEmpty() || lines.takeFirst() != "series,x,y" || lines.takeLast() != "") {
+            return {};
+        }
+        QList<Column> columns;
+        for (const QByteArray &line: lines) {
+            // Names may be quoted, numbers never are: split from the right
+            const qsizetype yAt = line.lastIndexOf(',');
+            const qsizetype xAt = line.lastIndexOf(',', yAt - 1);
+            QString name = QString::fromUtf8(line.left(xAt));
+            if (name.startsWith('"')) {
+                name = name.mid(1, name.size() - 2).replace(QStringLiteral("\"\""), QStringLiteral("\""));
+            }
+            if (columns.isEmpty() || columns.last().name != name) {
+                columns.append({name, {}});
+            }
+            columns.last().points.append({line.mid(xAt + 1, yAt - xAt - 1).toDouble(), line.mid(yAt + 1).toDouble()});
+        }
+        return columns;
+    }
+
+    // Header, then per series: name size, name, rows, x column, y column;
+    // all little-endian
+    QList<Column> parseBinary(const QByteArray &data) {
+        qsizetype at = 0;
+        bool ok = true;
+        auto take = [&](void *out, const qsizetype n) {
+            ok = ok && at + n <= data.size();
+            if (ok) {
+                std::memcpy(out, data.constData() + at, n);
+                at += n;
+            }
+        };
+        char magic[4]{};
+        quint32 version = 0;
+        quint32 seriesCount = 0;
+        take(magic, sizeof(magic));
+        take(&version, sizeof(version));
+        take(&seriesCount, sizeof(seriesCount));
+        version = qFromLittleEndian(version);
+        seriesCount = qFromLittleEndian(seriesCount);
+        if (!ok || std::memcmp(magic, "TPEX", 4) != 0 || version != 2) {
+            return {};
+        }
+        QList<Column> columns;
+        for (quint32 s = 0; s < seriesCount && ok; ++s) {
+            quint32 nameSize = 0;
+            take(&nameSize, sizeof(nameSize));
+            nameSize = qFromLittleEndian(nameSize);
+            QByteArray name(nameSize, '\0');
+            take(name.data(), nameSize);
+            quint64 rows = 0;
+            take(&rows, sizeof(rows));
+            rows = qFromLittleEndian(rows);
+            if (!ok || rows > static_cast<quint64>(data.size())) {
+                return {};
+            }
+            QList<qreal> x(static_cast<qsizetype>(rows));
+            QList<qreal> y(static_cast<qsizetype>(rows));
+            take(x.data(), x.size() * static_cast<qsizetype>(sizeof(qreal)));
+            take(y.data(), y.size() * static_cast<qsizetype>(sizeof(qreal)));
+            Column column{QString::fromUtf8(name), QList<QPointF>(x.size())};
+            for (qsizetype i = 0; i < x.size(); ++i) {
+                column.points[i] = QPointF(qFromLittleEndian(x[i]), qFromLittleEndian(y[i]));
+            }
+            columns.append(column);
+        }
+        return ok && at == data.size() ? columns : QList<Column>();
+    }
+}
+
+class SeriesExporterTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void csvHoldsEverySample();
+
+    void binaryHoldsEverySample();
+
+    void visibleKeepsTheViewRange();
+
+    void cleanupTestCase();
+
+private:
+    QList<QXYSeries *> exported() const { return {m_points, m_compact, m_blocks}; }
+
+    QTemporaryDir m_dir;
+    BlockStore m_store; // Outlives the view's series
+    ZoomAndScroll *m_view = nullptr;
+    QXYSeries *m_points = nullptr;
+    QXYSeries *m_compact = nullptr;
+    QXYSeries *m_blocks = nullptr;
+    QList<Column> m_expected;
+};
+
+void SeriesExporterTest::initTestCase() {
+    QVERIFY(m_dir.isValid());
+    auto *chart = new QChart();
+    m_view = new ZoomAndScroll(chart);
+
+    // Plain series (no tracker), name that needs CSV quoting
+    m_points = new QLineSeries();
+    m_points->setName(QStringLiteral("plain, \"quoted\""));
+    m_points->replace(ramp(1000, 0.01));
+    chart->addSeries(m_points);
+
+    auto *compact = new LineSeries(m_view);
+    compact->setName(QStringLiteral("compact"));
+    QList<float> values(200000);
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<float>(i % 101) * 0.5f;
+    }
+    const CompactSamples samples = CompactSamples::uniform(0, 0.0001, values);
+    chart->addSeries(compact);
+    compact->setCompactData(samples);
+    m_compact = compact;
+
+    auto *blocks = new LineSeries(m_view);
+    blocks->setName(QStringLiteral("blocks"));
+    m_store.append(ramp(150000, 0.0002)); // Several chunks, across blocks
+    chart->addSeries(blocks);
+    blocks->setBlockData(&m_store);
+    m_blocks = blocks;
+
+    m_expected = {{m_points->name(), m_points->points()}, {QStringLiteral("compact"), samples.mid(0, samples.size())},
+                  {QStringLiteral("blocks"), m_store.mid(0, m_store.size())}};
+}
+
+void SeriesExporterTest::csvHoldsEverySample() {
+    const QString path = m_dir.filePath(QStringLiteral("full.csv"));
+    QCOMPARE(exportTo(*m_view, path, exported(), SeriesExporter::Format::Csv, SeriesExporter::Range::Full), QString());
+    const QList<Column> columns = parseCsv(contents(path));
+    QCOMPARE(columns.size(), m_expected.size());
+    for (qsizetype s = 0; s < columns.size(); ++s) {
+        QCOMPARE(columns[s].name, m_expected[s].name);
+        QCOMPARE(columns[s].points, m_expected[s].points); // Shortest round-trip digits: exact
+    }
+}
+
+void SeriesExporterTest::binaryHoldsEverySample() {
+    const QString path = m_dir.filePath(QStringLiteral("full.bin"));
+    QCOMPARE(exportTo(*m_view, path, exported(), SeriesExporter::Format::Binary, SeriesExporter::Range::Full),
+             QString());
+    const QByteArray data = contents(path);
+    qsizetype expectedBytes = 12;
+    for (const Column &column: m_expected) {
+        expectedBytes += 4 + column.name.toUtf8().size() + 8 + column.points.size() * 2 * 8;
+    }
+    QCOMPARE(data.size(), expectedBytes);
+    const QList<Column> columns = parseBinary(data);
+    QCOMPARE(columns.size(), m_expected.size());
+    for (qsizetype s = 0; s < columns.size(); ++s) {
+        QCOMPARE(columns[s].name, m_expected[s].name);
+        QCOMPARE(columns[s].points, m_expected[s].points);
+    }
+}
+
+void SeriesExporterTest::visibleKeepsTheViewRange() {
+    // An unsorted plain series goes through the row filter
+    QList<QPointF> shuffled = ramp(1000, 0.01);
+    std::reverse(shuffled.begin(), shuffled.begin() + 500);
+    auto *unsorted = new QLineSeries();
+    unsorted->setName(QStringLiteral("unsorted"));
+    unsorted->replace(shuffled);
+    m_view->chart()->addSeries(unsorted);
+
+    m_view->chart()->createDefaultAxes();
+    constexpr qreal xMin = 2.5;
+    constexpr qreal xMax = 7.25;
+    for (QAbstractAxis *axis: m_view->chart()->axes(Qt::Horizontal)) {
+        static_cast<QValueAxis *>(axis)->setRange(xMin, xMax);
+    }
+    m_view->rangeUpdate();
+    QCOMPARE(m_view->viewLimits().xMin, xMin);
+    QCOMPARE(m_view->viewLimits().xMax, xMax);
+
+    QList<QXYSeries *> series = exported();
+    series.append(unsorted);
+    QList<Column> expected = m_expected;
+    expected.append({QStringLiteral("unsorted"), shuffled});
+    for (Column &column: expected) {
+        column.points = inRange(column.points, xMin, xMax);
+        QVERIFY(!column.points.isEmpty());
+    }
+
+    const QString csvPath = m_dir.filePath(QStringLiteral("visible.csv"));
+    const QString binaryPath = m_dir.filePath(QStringLiteral("visible.bin"));
+    QCOMPARE(exportTo(*m_view, csvPath, series, SeriesExporter::Format::Csv, SeriesExporter::Range::Visible),
+             QString());
+    QCOMPARE(exportTo(*m_view, binaryPath, series, SeriesExporter::Format::Binary, SeriesExporter::Range::Visible),
+             QString());
+    for (const QList<Column> &columns: {parseCsv(contents(csvPath)), parseBinary(contents(binaryPath))}) {
+        QCOMPARE(columns.size(), expected.size());
+        for (qsizetype s = 0; s < columns.size(); ++s) {
+            QCOMPARE(columns[s].name, expected[s].name);
+            QCOMPARE(columns[s].points, expected[s].points);
+        }
+    }
+}
+
+void SeriesExporterTest::cleanupTestCase() {
+    delete m_view; // Deletes the chart and its series before the block store
+}
+
+QTEST_MAIN(SeriesExporterTest)
+
+#include "seriesExporterTest.moc"
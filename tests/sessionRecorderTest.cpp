@@ -0,0 +1,256 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// SessionRecorder and SessionReplayer: a recorded session loads back as the
+// events the view received, and a deterministic replay from a different
+// state restores the recorded start and ends in the recorded view.
+
+#include "frameScheduler.h"
+#include "sessionRecorder.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QValueAxis>
+#include <QWheelEvent>
+#include <cmath>
+
+namespace {
+    QList<QPointF> makeSeries(const qsizetype count) {
+        QList<QPointF> points(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            const qreal x = static_cast<qreal>(i) / static_cast<qreal>(count) * 100;
+            points[i] = QPointF(x, std::sin(x * 0.2));
+        }
+        return points;
+    }
+
+    void setRanges(ZoomAndScroll &view, const ViewLimits &limits) {
+        for (QAbstractAxis *axis: view.chart()->axes()) {
+            if (auto *valueAxis = qobject_cast<QValueAxis *>(axis)) {
+                if (axis->orientation() == Qt::Horizontal) {
+                    valueAxis->setRange(limits.xMin, limits.xMax);
+                } else {
+                    valueAxis->setRange(limits.yMin, limits.yMax);
+                }
+            }
+        }
+        view.rangeUpdate();
+    }
+
+    bool near(const ViewLimits &a, const ViewLimits &b) {
+        const qreal tx = 1e-6 * std::abs(a.xMax - a.xMin);
+        const qreal ty = 1e-6 * std::abs(a.yMax - a.yMin);
+        return std::abs(a.xMin - b.xMin) <= tx && std::abs(a.xMax - b.xMax) <= tx &&
+               std::abs(a.yMin - b.yMin) <= ty && std::abs(a.yMax - b.yMax) <= ty;
+    }
+}
+
+class SessionRecorderTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void loadsWhatWasRecorded();
+
+    void replayEndsInTheRecordedView();
+
+    void cleanupTestCase();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_path;
+    ZoomAndScroll *m_view = nullptr;
+    ViewLimits m_full{};
+    ViewLimits m_recordedEnd{};
+    QList<SessionRecord> m_sent; // Input events, as the recorder should store them
+    qsizetype m_viewChanges = 0;
+
+    // Lets the view go idle (no frame for a few intervals, batch rendered)
+    void settle() const;
+
+    // Viewport position at a fraction of the plot area
+    [[nodiscard]] QPointF plotPoint(qreal fx, qreal fy) const;
+
+    void mouse(QEvent::Type type, const QPointF &pos, Qt::MouseButton button, Qt::MouseButtons buttons);
+
+    void wheel(const QPointF &pos, int angle);
+
+    void key(int code);
+};
+
+void SessionRecorderTest::initTestCase() {
+    QVERIFY(m_dir.isValid());
+    m_path = m_dir.filePath(QStringLiteral("session.tpsr"));
+    auto *chart = new QChart();
+    m_view = new ZoomAndScroll(chart);
+    ZoomAndScroll &view = *m_view;
+    auto *series = new LineSeries(&view);
+    series->replace(makeSeries(5000));
+    chart->addSeries(series);
+    view.updateXLimits(chart);
+    chart->createDefaultAxes();
+    m_full = {view.minX, view.maxX, view.minY, view.maxY};
+    setRanges(view, m_full);
+    view.resize(800, 600);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    view.toggleState = false;
+    view.toggleLines = false;
+
+    // Hover, wheel zoom, rubber-band zoom, tracking on (key T), hover again
+    SessionRecorder recorder(&view);
+    QVERIFY(recorder.start(m_path));
+    connect(&view, &ZoomAndScroll::viewChanged, this, [this]() { ++m_viewChanges; });
+    settle();
+    mouse(QEvent::MouseMove, plotPoint(0.5, 0.5), Qt::NoButton, Qt::NoButton);
+    wheel(plotPoint(0.4, 0.6), 120);
+    mouse(QEvent::MouseButtonPress, plotPoint(0.3, 0.3), Qt::LeftButton, Qt::LeftButton);
+    mouse(QEvent::MouseMove, plotPoint(0.7, 0.7), Qt::NoButton, Qt::LeftButton);
+    mouse(QEvent::MouseButtonRelease, plotPoint(0.7, 0.7), Qt::LeftButton, Qt::NoButton);
+    key(Qt::Key_T);
+    mouse(QEvent::MouseMove, plotPoint(0.6, 0.5), Qt::NoButton, Qt::NoButton);
+    recorder.stop();
+    disconnect(&view, &ZoomAndScroll::viewChanged, this, nullptr);
+    QVERIFY(!recorder.isRecording());
+    QVERIFY(m_viewChanges >= 2); // Both zooms changed the view
+    QVERIFY(view.toggleState);
+    m_recordedEnd = view.viewLimits();
+}
+
+void SessionRecorderTest::settle() const {
+    const FrameScheduler *scheduler = FrameScheduler::instance();
+    const qint64 quiet = 3 * scheduler->frameInterval();
+    quint64 frames = scheduler->frameCount();
+    QElapsedTimer clock;
+    clock.start();
+    while (clock.elapsed() < quiet) {
+        QCoreApplication::processEvents();
+        if (scheduler->frameCount() != frames) {
+            frames = scheduler->frameCount();
+            clock.restart();
+        }
+    }
+    scheduler->waitForBatch();
+    QCoreApplication::processEvents();
+}
+
+QPointF SessionRecorderTest::plotPoint(const qreal fx, const qreal fy) const {
+    const QRectF plot = m_view->chart()->plotArea();
+    return m_view->mapFromScene(QPointF(plot.left() + fx * plot.width(), plot.top() + fy * plot.height()));
+}
+
+void SessionRecorderTest::mouse(const QEvent::Type type, const QPointF &pos, const Qt::MouseButton button,
+                                const Qt::MouseButtons buttons) {
+    QMouseEvent event(type, pos, m_view->viewport()->mapToGlobal(pos), button, buttons, Qt::NoModifier);
+    QCoreApplication::sendEvent(m_view->viewport(), &event);
+    settle();
+    SessionRecord record;
+    record.kind = SessionRecord::Kind::Mouse;
+    record.type = static_cast<quint16>(type);
+    record.pos = pos;
+    record.button = button;
+    record.buttons = buttons.toInt();
+    m_sent.append(record);
+}
+
+void SessionRecorderTest::wheel(const QPointF &pos, const int angle) {
+    QWheelEvent event(pos, m_view->viewport()->mapToGlobal(pos), QPoint(), QPoint(0, angle), Qt::NoButton,
+                      Qt::NoModifier, Qt::NoScrollPhase, false);
+    QCoreApplication::sendEvent(m_view->viewport(), &event);
+    settle();
+    SessionRecord record;
+    record.kind = SessionRecord::Kind::Wheel;
+    record.pos = pos;
+    record.button = static_cast<quint32>(angle);
+    m_sent.append(record);
+}
+
+void SessionRecorderTest::key(const int code) {
+    QKeyEvent event(QEvent::KeyPress, code, Qt::NoModifier);
+    QCoreApplication::sendEvent(m_view, &event);
+    settle();
+    SessionRecord record;
+    record.kind = SessionRecord::Kind::Key;
+    record.button = static_cast<quint32>(code);
+    m_sent.append(record);
+}
+
+void SessionRecorderTest::loadsWhatWasRecorded() {
+    SessionReplayer replayer;
+    QVERIFY2(replayer.load(m_path), qPrintable(replayer.errorString()));
+    QList<SessionRecord> input;
+    qsizetype views = 0;
+    qint64 lastUs = 0;
+    for (const SessionRecord &record: replayer.records()) {
+        QVERIFY(record.timeUs >= lastUs);
+        lastUs = record.timeUs;
+        if (record.kind == SessionRecord::Kind::View) {
+            ++views;
+        } else if (record.kind != SessionRecord::Kind::Resize) {
+            input.append(record);
+        }
+    }
+    QCOMPARE(views, m_viewChanges);
+    QCOMPARE(input.size(), m_sent.size());
+    for (qsizetype i = 0; i < input.size(); ++i) {
+        const SessionRecord &got = input[i];
+        const SessionRecord &sent = m_sent[i];
+        QCOMPARE(got.kind, sent.kind);
+        QCOMPARE(got.button, sent.button);
+        if (sent.kind == SessionRecord::Kind::Key)
+            continue;
+        QCOMPARE(got.buttons, sent.buttons);
+        QVERIFY(std::abs(got.pos.x() - sent.pos.x()) <= 1.0 / 256); // Stored in 1/256 pixel
+        QVERIFY(std::abs(got.pos.y() - sent.pos.y()) <= 1.0 / 256);
+        if (sent.kind == SessionRecord::Kind::Mouse) {
+            QCOMPARE(got.type, sent.type);
+        }
+    }
+}
+
+void SessionRecorderTest::replayEndsInTheRecordedView() {
+    // Start from another state: replay must restore the recorded one
+    setRanges(*m_view, m_full);
+    m_view->toggleState = false;
+    m_view->toggleLines = true;
+    settle();
+
+    SessionReplayer replayer;
+    QVERIFY(replayer.load(m_path));
+    const SessionReplayer::Stats stats = replayer.replay(m_view);
+    QCOMPARE(stats.events, m_sent.size());
+    QCOMPARE(stats.viewChecks, m_viewChanges);
+    QCOMPARE(stats.viewMismatches, qsizetype{0});
+    QVERIFY(stats.p50Ms <= stats.p99Ms && stats.p99Ms <= stats.maxMs);
+    QVERIFY(!m_view->toggleLines); // Recorded start
+    QVERIFY(m_view->toggleState); // Key T, replayed
+    QVERIFY(near(m_view->viewLimits(), m_recordedEnd));
+}
+
+void SessionRecorderTest::cleanupTestCase() {
+    delete m_view;
+}
+
+QTEST_MAIN(SessionRecorderTest)
+
+#include "sessionRecorderTest.moc"
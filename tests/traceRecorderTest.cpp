@@ -0,0 +1,194 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// TraceRecorder: toJson() emits valid trace-event JSON (thread names, one
+// complete event per span with its slot argument), spans recorded while
+// disabled are dropped, and the ring keeps the newest spans.
+
+#include "traceRecorder.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+#include <QThread>
+
+namespace {
+    struct Trace {
+        QHash<int, QString> threadNames; // tid -> name
+        QList<QJsonObject> spans; // Complete ("X") events, in file order
+    };
+
+    // Empty spans and names when the JSON does not parse
+    Trace parse(const QByteArray &json) {
+        QJsonParseError error{};
+        const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+        Trace trace;
+        if (error.error != QJsonParseError::NoError) {
+            return trace;
+        }
+        for (const QJsonValue &value: document.object().value(QStringLiteral("traceEvents")).toArray()) {
+            const QJsonObject event = value.toObject();
+            if (event.value(QStringLiteral("ph")).toString() == QStringLiteral("M")) {
+                trace.threadNames.insert(event.value(QStringLiteral("tid")).toInt(),
+                                         event.value(QStringLiteral("args")).toObject().value(
+                                             QStringLiteral("name")).toString());
+            } else {
+                trace.spans.append(event);
+            }
+        }
+        return trace;
+    }
+
+    Trace current() {
+        return parse(TraceRecorder::instance().toJson());
+    }
+}
+
+class TraceRecorderTest final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void toJsonHoldsCompleteEvents();
+
+    void disabledDropsSpans();
+
+    void ringKeepsTheNewest();
+
+    void clearKeepsRecording();
+
+    void cleanup();
+};
+
+void TraceRecorderTest::init() {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    recorder.setEnabled(false);
+    recorder.setCapacity(TraceRecorder::defaultCapacity);
+}
+
+void TraceRecorderTest::toJsonHoldsCompleteEvents() {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    QVERIFY(parse(recorder.toJson()).spans.isEmpty());
+    QVERIFY(!QJsonDocument::fromJson(recorder.toJson()).isNull());
+
+    recorder.setEnabled(true);
+    recorder.record("compute", 1000000, 1002500, 7);
+    recorder.record("render", 1001000, 1001500);
+    QThread *worker = QThread::create([]() { TraceRecorder::instance().record("worker", 1003000, 1004000, 0); });
+    worker->setObjectName(QStringLiteral("Tracker"));
+    worker->start();
+    QVERIFY(worker->wait(5000));
+    delete worker;
+    recorder.setEnabled(false);
+
+    const Trace trace = current();
+    QCOMPARE(trace.spans.size(), qsizetype{3});
+    // Sorted by begin, microseconds from the first span
+    const QJsonObject &compute = trace.spans[0];
+    QCOMPARE(compute.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+    QCOMPARE(compute.value(QStringLiteral("name")).toString(), QStringLiteral("compute"));
+    QCOMPARE(compute.value(QStringLiteral("ts")).toDouble(), 0.0);
+    QCOMPARE(compute.value(QStringLiteral("dur")).toDouble(), 2.5);
+    QCOMPARE(compute.value(QStringLiteral("args")).toObject().value(QStringLiteral("slot")).toInt(), 7);
+    QCOMPARE(compute.value(QStringLiteral("pid")).toInteger(), QCoreApplication::applicationPid());
+
+    const QJsonObject &render = trace.spans[1];
+    QCOMPARE(render.value(QStringLiteral("name")).toString(), QStringLiteral("render"));
+    QCOMPARE(render.value(QStringLiteral("ts")).toDouble(), 1.0);
+    QCOMPARE(render.value(QStringLiteral("dur")).toDouble(), 0.5);
+    QVERIFY(!render.contains(QStringLiteral("args"))); // No slot argument
+
+    const QJsonObject &onWorker = trace.spans[2];
+    QCOMPARE(onWorker.value(QStringLiteral("name")).toString(), QStringLiteral("worker"));
+    QCOMPARE(onWorker.value(QStringLiteral("args")).toObject().value(QStringLiteral("slot")).toInt(), 0);
+
+    // Each thread is named once, by its object name or as the GUI thread
+    const int guiThread = compute.value(QStringLiteral("tid")).toInt();
+    const int workerThread = onWorker.value(QStringLiteral("tid")).toInt();
+    QCOMPARE(render.value(QStringLiteral("tid")).toInt(), guiThread);
+    QVERIFY(guiThread != workerThread);
+    QCOMPARE(trace.threadNames.value(guiThread), QStringLiteral("GUI"));
+    QCOMPARE(trace.threadNames.value(workerThread), QStringLiteral("Tracker"));
+}
+
+void TraceRecorderTest::disabledDropsSpans() {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    recorder.setEnabled(true);
+    recorder.record("kept", 100, 200);
+    {
+        TRACKPLOT_TRACE_SPAN("scoped", 3);
+    }
+    recorder.setEnabled(false);
+    recorder.record("dropped", 300, 400);
+    {
+        TRACKPLOT_TRACE_SPAN("droppedScope");
+    }
+
+    const Trace trace = current();
+    QCOMPARE(trace.spans.size(), qsizetype{2});
+    QCOMPARE(trace.spans[0].value(QStringLiteral("name")).toString(), QStringLiteral("kept"));
+    QCOMPARE(trace.spans[1].value(QStringLiteral("name")).toString(), QStringLiteral("scoped"));
+    QCOMPARE(trace.spans[1].value(QStringLiteral("args")).toObject().value(QStringLiteral("slot")).toInt(), 3);
+}
+
+void TraceRecorderTest::ringKeepsTheNewest() {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    recorder.setCapacity(5);
+    QCOMPARE(recorder.capacity(), qsizetype{8}); // Rounded up to a power of two
+    recorder.setEnabled(true);
+    for (qint64 i = 0; i < 20; ++i) {
+        recorder.record("span", i * 1000, i * 1000 + 10, i);
+    }
+    recorder.setEnabled(false);
+
+    const Trace trace = current();
+    QCOMPARE(trace.spans.size(), qsizetype{8});
+    for (qsizetype k = 0; k < trace.spans.size(); ++k) {
+        QCOMPARE(trace.spans[k].value(QStringLiteral("args")).toObject().value(QStringLiteral("slot")).toInt(),
+                 static_cast<int>(12 + k));
+        QCOMPARE(trace.spans[k].value(QStringLiteral("ts")).toDouble(), static_cast<double>(k)); // From span 12
+    }
+}
+
+void TraceRecorderTest::clearKeepsRecording() {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    recorder.setEnabled(true);
+    recorder.record("before", 0, 10);
+    recorder.clear();
+    QVERIFY(current().spans.isEmpty());
+    QVERIFY(TraceRecorder::enabled()); // clear() restores the previous state
+    recorder.record("after", 20, 30);
+    recorder.setCapacity(32);
+    QVERIFY(TraceRecorder::enabled());
+    QVERIFY(current().spans.isEmpty()); // A new ring starts empty
+
+    recorder.record("resized", 40, 50);
+    const Trace trace = current();
+    QCOMPARE(trace.spans.size(), qsizetype{1});
+    QCOMPARE(trace.spans[0].value(QStringLiteral("name")).toString(), QStringLiteral("resized"));
+}
+
+void TraceRecorderTest::cleanup() {
+    TraceRecorder::instance().setEnabled(false);
+}
+
+QTEST_GUILESS_MAIN(TraceRecorderTest)
+
+#include "traceRecorderTest.moc"
@@ -0,0 +1,281 @@
+/*
+All-in-one custom zoom and tracking capabilities for Qt charts series
+
+Copyright (C) 2025 Criogenox
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Headless batch renderer: one PNG per dataset, laid out like the example
+// window (same decimation and auto-range logic), on the offscreen platform.
+// Loading, decimation and PNG encoding run on the thread pool; widgets can
+// only be laid out and painted on the GUI thread, so that step is serial.
+// At most --in-flight datasets (data plus image) are held at any time.
+// Datasets are CSV: "x,y" rows (one series named after the file) or the
+// "series,x,y" rows written by SeriesExporter.
+// Usage: batchRender [--size WxH] [--in-flight N] [--out DIR] datasets...
+
+#include "customEvents.h"
+#include "decimation.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QThread>
+#include <QTimer>
+#include <QValueAxis>
+#include <QtConcurrent/QtConcurrent>
+#include <charconv>
+#include <cstdio>
+
+namespace {
+    struct SeriesData {
+        QString name;
+        QList<QPointF> points; // Decimated to the image width
+    };
+
+    struct ChartData {
+        QString path;
+        QList<SeriesData> series;
+        QString error;
+    };
+
+    bool parseNumber(const QByteArray &field, qreal &value) {
+        const char *first = field.constData();
+        const char *last = first + field.size();
+        while (first < last && *first == ' ') ++first;
+        return std::from_chars(first, last, value).ec == std::errc();
+    }
+
+    // Splits one CSV row; quoted fields may hold commas ("" escapes a quote)
+    QList<QByteArray> splitRow(const QByteArray &line) {
+        QList<QByteArray> fields(1);
+        bool quoted = false;
+        for (qsizetype i = 0; i < line.size(); ++i) {
+            const char c = line[i];
+            if (c == '"') {
+                if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+                    fields.last().append('"');
+                    ++i;
+                } else {
+                    quoted = !quoted;
+                }
+            } else if (c == ',' && !quoted) {
+                fields.append(QByteArray());
+            } else if (c != '\r') {
+                fields.last().append(c);
+            }
+        }
+        return fields;
+    }
+
+    // Worker thread: parse and decimate (pure, no widgets)
+    ChartData loadChart(const QString &path, const int columns) {
+        ChartData chart{path, {}, {}};
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            chart.error = file.errorString();
+            return chart;
+        }
+        QList<QString> names;
+        QList<QList<QPointF>> points;
+        const QString fileSeries = QFileInfo(path).completeBaseName();
+        while (!file.atEnd()) {
+            const QList<QByteArray> fields = splitRow(file.readLine().trimmed());
+            const bool named = fields.size() >= 3;
+            qreal x = 0;
+            qreal y = 0;
+            if (fields.size() < 2 || !parseNumber(fields[named ? 1 : 0], x) ||
+                !parseNumber(fields[named ? 2 : 1], y)) {
+                continue; // Header or malformed row
+            }
+            const QString name = named ? QString::fromUtf8(fields[0]) : fileSeries;
+            qsizetype index = names.indexOf(name);
+            if (index < 0) {
+                names.append(name);
+                points.append(QList<QPointF>());
+                index = names.size() - 1;
+            }
+            points[index].append(QPointF(x, y));
+        }
+        for (qsizetype i = 0; i < names.size(); ++i) {
+            chart.series.append(SeriesData{names[i], decimateOverview(points[i], columns)});
+        }
+        if (chart.series.isEmpty()) {
+            chart.error = QStringLiteral("no data rows");
+        }
+        return chart;
+    }
+
+    // GUI thread: same layout as the example window, painted offscreen
+    QImage renderChart(const ChartData &data, const QSize &size) {
+        static const QColor palette[] = {Qt::blue, Qt::darkGreen, Qt::red, Qt::darkMagenta};
+        auto *chart = new QChart();
+        ZoomAndScroll view(chart);
+        for (qsizetype i = 0; i < data.series.size(); ++i) {
+            auto *series = new LineSeries(&view);
+            series->replace(data.series[i].points);
+            series->setName(data.series[i].name);
+            QPen pen(palette[i % std::size(palette)]);
+            pen.setWidth(2);
+            series->setPen(pen);
+            chart->addSeries(series);
+        }
+        view.updateXLimits(chart);
+        chart->createDefaultAxes();
+        for (QAbstractAxis *axis: chart->axes()) {
+            if (auto *valueAxis = qobject_cast<QValueAxis *>(axis)) {
+                valueAxis->setTickCount(11);
+                valueAxis->setGridLinePen(QColor(200, 200, 200));
+                if (axis->orientation() == Qt::Horizontal) {
+                    valueAxis->setRange(view.minX, view.maxX);
+                } else {
+                    valueAxis->setRange(view.minY, view.maxY);
+                }
+            }
+        }
+        view.rangeUpdate();
+        chart->setTitle(QFileInfo(data.path).completeBaseName());
+        chart->setTitleFont(QFont("Arial", 14, QFont::Bold));
+        QLinearGradient gradient(0, 0, 0, size.height());
+        gradient.setColorAt(0, QColor(255, 255, 255));
+        gradient.setColorAt(0.5, QColor(235, 250, 255));
+        gradient.setColorAt(1, QColor(162, 210, 232));
+        chart->setBackgroundBrush(QBrush(gradient));
+        chart->legend()->setAlignment(Qt::AlignTop);
+
+        view.setAttribute(Qt::WA_DontShowOnScreen);
+        view.resize(size);
+        view.show();
+        // Chart layout without spinning the event loop: this runs inside a
+        // watcher's finished handler, which must not re-enter (and start the
+        // next render on top of this one). Only the layout requests are sent.
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+        if (chart->layout()) {
+            chart->layout()->activate();
+        }
+        return view.grab().toImage();
+    }
+
+    class BatchRenderer {
+    public:
+        BatchRenderer(QStringList paths, const QString &outDir, const QSize size, const int inFlight)
+            : m_paths(std::move(paths)), m_outDir(outDir), m_size(size), m_inFlight(inFlight) {
+        }
+
+        void start() {
+            for (int i = 0; i < m_inFlight; ++i) {
+                next();
+            }
+            if (m_active == 0) {
+                QCoreApplication::exit(0);
+            }
+        }
+
+    private:
+        QStringList m_paths;
+        QDir m_outDir;
+        QSize m_size;
+        int m_inFlight;
+        qsizetype m_next = 0;
+        int m_active = 0;
+        int m_failed = 0;
+
+        // Admits the next dataset while under the in-flight limit
+        void next() {
+            if (m_next >= m_paths.size()) {
+                if (m_active == 0) {
+                    QCoreApplication::exit(m_failed > 0 ? 1 : 0);
+                }
+                return;
+            }
+            const QString path = m_paths[m_next++];
+            ++m_active;
+            auto *loading = new QFutureWatcher<ChartData>(qApp);
+            QObject::connect(loading, &QFutureWatcherBase::finished, qApp, [this, loading]() {
+                const ChartData data = loading->result();
+                loading->deleteLater();
+                if (!data.error.isEmpty()) {
+                    fail(data.path, data.error);
+                    return;
+                }
+                save(data.path, renderChart(data, m_size));
+            });
+            loading->setFuture(QtConcurrent::run(loadChart, path, m_size.width()));
+        }
+
+        void save(const QString &path, const QImage &image) {
+            const QString target = m_outDir.filePath(QFileInfo(path).completeBaseName() + ".png");
+            auto *saving = new QFutureWatcher<bool>(qApp);
+            QObject::connect(saving, &QFutureWatcherBase::finished, qApp, [this, saving, path]() {
+                const bool saved = saving->result();
+                saving->deleteLater();
+                if (!saved) {
+                    fail(path, QStringLiteral("cannot write image"));
+                    return;
+                }
+                std::printf("%s\n", qPrintable(path));
+                done();
+            });
+            saving->setFuture(QtConcurrent::run([image, target]() { return image.save(target, "PNG"); }));
+        }
+
+        void fail(const QString &path, const QString &error) {
+            std::fprintf(stderr, "%s: %s\n", qPrintable(path), qPrintable(error));
+            ++m_failed;
+            done();
+        }
+
+        void done() {
+            --m_active;
+            next();
+        }
+    };
+}
+
+int main(int argc, char *argv[]) {
+    // Headless unless told otherwise
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders each CSV dataset to a PNG chart.");
+    parser.addHelpOption();
+    parser.addOption({"size", "Image size.", "WxH", "1600x900"});
+    parser.addOption({"in-flight", "Datasets held in memory at once.", "N",
+                      QString::number(std::max(2, QThread::idealThreadCount()))});
+    parser.addOption({"out", "Output directory.", "DIR", "."});
+    parser.addPositionalArgument("datasets", "CSV files to render.", "datasets...");
+    parser.process(app);
+
+    const QStringList size = parser.value("size").split('x');
+    const QSize imageSize(size.value(0).toInt(), size.value(1).toInt());
+    const int inFlight = parser.value("in-flight").toInt();
+    if (imageSize.isEmpty() || inFlight < 1 || parser.positionalArguments().isEmpty()) {
+        parser.showHelp(1);
+    }
+    if (!QDir().mkpath(parser.value("out"))) {
+        std::fprintf(stderr, "cannot create %s\n", qPrintable(parser.value("out")));
+        return 1;
+    }
+
+    BatchRenderer renderer(parser.positionalArguments(), parser.value("out"), imageSize, inFlight);
+    QTimer::singleShot(0, [&renderer]() { renderer.start(); });
+    return QApplication::exec();
+}